@@ -0,0 +1,44 @@
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces global allocation functions to count allocations made while benchmarking
+
+static size_t allocation_count = 0;
+static size_t allocation_bytes = 0;
+
+auto operator new(size_t size) -> void *
+{
+	allocation_count++;
+	allocation_bytes += size;
+
+	auto *ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t /*size*/) noexcept
+{
+	std::free(ptr);
+}
+
+void bench::count_allocations(const std::string &name, const std::function<void()> &run)
+{
+	const auto count = allocation_count;
+	const auto bytes = allocation_bytes;
+
+	run();
+
+	std::cout << "  " << name << ": "
+		<< allocation_count - count << " allocations, "
+		<< (allocation_bytes - bytes) / 1024 << " kB" << std::endl;
+}
@@ -0,0 +1,201 @@
+#include "bench.hpp"
+
+#include "lib/spotify/api.hpp"
+#include "lib/paths/paths.hpp"
+
+class api_bench_paths: public lib::paths
+{
+public:
+	auto config_file() const -> ghc::filesystem::path override
+	{
+		return "spotify-qt-api-bench.json";
+	}
+
+	auto cache() const -> ghc::filesystem::path override
+	{
+		return "cache";
+	}
+};
+
+/**
+ * Responds to GET requests synchronously from prepared pages
+ */
+class api_bench_http_client: public lib::http_client
+{
+public:
+	std::map<std::string, std::string> responses;
+
+	void get(const std::string &url, const lib::headers &/*headers*/,
+		lib::callback<std::string> &callback) const override
+	{
+		callback(responses.at(url));
+	}
+
+	void put(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &callback) const override
+	{
+		callback(std::string());
+	}
+
+	void post(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &callback) const override
+	{
+		callback(std::string());
+	}
+
+	auto post(const std::string &/*url*/, const lib::headers &/*headers*/,
+		const std::string &/*post_data*/) const -> std::string override
+	{
+		return std::string();
+	}
+
+	void del(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &callback) const override
+	{
+		callback(std::string());
+	}
+};
+
+/**
+ * API with album_tracks as it was before results were moved
+ */
+class api_bench: public lib::spt::api
+{
+public:
+	api_bench(lib::settings &settings, const lib::http_client &http_client)
+		: api(settings, http_client)
+	{
+	}
+
+	void previous_album_tracks(const lib::spt::album &album,
+		lib::callback<std::vector<lib::spt::track>> &callback)
+	{
+		previous_get_items(lib::fmt::format("albums/{}/tracks?limit=50", album.id),
+			[album, callback](const std::vector<lib::spt::track> &results)
+			{
+				std::vector<lib::spt::track> tracks;
+				tracks.reserve(results.size());
+				for (const auto &result : results)
+				{
+					lib::spt::track track = result;
+					track.album.name = album.name;
+					tracks.push_back(track);
+				}
+				callback(tracks);
+			});
+	}
+
+private:
+	void previous_get_items(const std::string &url, lib::callback<nlohmann::json> &callback)
+	{
+		constexpr size_t api_prefix_length = 27;
+		const auto relative_url = lib::strings::starts_with(url, "https://api.spotify.com/v1/")
+			? url.substr(api_prefix_length)
+			: url;
+
+		get(relative_url, [this, callback](const nlohmann::json &json)
+		{
+			const auto &items = json.at("items");
+			if (json.contains("next") && json.at("next").is_string())
+			{
+				const auto &next = json.at("next").get<std::string>();
+				previous_get_items(next, [items, callback](const nlohmann::json &next)
+				{
+					callback(lib::json::combine(items, next));
+				});
+				return;
+			}
+			callback(items);
+		});
+	}
+};
+
+static auto bench_page(size_t page, size_t pages, size_t page_size) -> std::string
+{
+	auto items = nlohmann::json::array();
+	for (size_t i = 0; i < page_size; i++)
+	{
+		const auto index = page * page_size + i;
+		items.push_back({
+			{"id", lib::fmt::format("{}", 1000000000 + index)},
+			{"name", lib::fmt::format("Track {}", index)},
+			{"duration_ms", 180000},
+			{"is_playable", true},
+			{"artists", {
+				{
+					{"id", "artist"},
+					{"name", "Artist"},
+				},
+			}},
+		});
+	}
+
+	return nlohmann::json{
+		{"total", pages * page_size},
+		{"items", items},
+		{"next", page + 1 < pages
+			? nlohmann::json(lib::fmt::format("https://api.spotify.com/v1/"
+				"albums/album/tracks?offset={}&limit=50", (page + 1) * page_size))
+			: nlohmann::json()},
+	}.dump();
+}
+
+static void bench_album_tracks(size_t pages)
+{
+	constexpr size_t page_size = 50;
+	constexpr size_t iterations = 3;
+
+	api_bench_paths paths;
+	lib::settings settings(paths);
+	settings.account.last_refresh = lib::date_time::seconds_since_epoch();
+
+	api_bench_http_client http_client;
+	for (size_t page = 0; page < pages; page++)
+	{
+		const auto url = page == 0
+			? std::string("https://api.spotify.com/v1/albums/album/tracks?limit=50")
+			: lib::fmt::format("https://api.spotify.com/v1/"
+				"albums/album/tracks?offset={}&limit=50", page * page_size);
+		http_client.responses[url] = bench_page(page, pages, page_size);
+	}
+
+	api_bench api(settings, http_client);
+	api.refresh(false);
+
+	lib::spt::album album;
+	album.id = "album";
+	album.name = "Album";
+
+	std::cout << "  " << pages << " pages, " << pages * page_size << " tracks" << std::endl;
+
+	const auto previous = [&api, &album]()
+	{
+		api.previous_album_tracks(album, [](const std::vector<lib::spt::track> &tracks)
+		{
+			// Consumer keeps its own copy, as the result was only borrowed
+			auto copy = std::make_shared<const std::vector<lib::spt::track>>(tracks);
+			bench::keep(copy);
+		});
+	};
+
+	const auto moved = [&api, &album]()
+	{
+		api.album_tracks(album, [](std::vector<lib::spt::track> &&tracks)
+		{
+			auto owned = std::make_shared<const std::vector<lib::spt::track>>(std::move(tracks));
+			bench::keep(owned);
+		});
+	};
+
+	bench::count_allocations("previous", previous);
+	bench::count_allocations("moved", moved);
+	bench::measure("previous", iterations, previous);
+	bench::measure("moved", iterations, moved);
+}
+
+static bench::registrar api_album_tracks("api album tracks", []()
+{
+	bench_album_tracks(1);
+	bench_album_tracks(20);
+	bench_album_tracks(100);
+});
@@ -0,0 +1,119 @@
+#include "bench.hpp"
+
+#include "lib/arena.hpp"
+#include "lib/arenajson.hpp"
+#include "lib/spotify/track.hpp"
+
+/**
+ * Page of playlist tracks, with roughly the fields the API returns
+ */
+static auto bench_playlist_page(size_t page_size) -> std::string
+{
+	auto items = nlohmann::json::array();
+	for (size_t i = 0; i < page_size; i++)
+	{
+		const auto id = lib::fmt::format("{}", 1000000000000000000 + i);
+		items.push_back({
+			{"added_at", "2021-01-02T03:04:05Z"},
+			{"added_by", {
+				{"id", "user"},
+				{"type", "user"},
+				{"uri", "spotify:user:user"},
+			}},
+			{"is_local", false},
+			{"track", {
+				{"id", id},
+				{"name", lib::fmt::format("Track {}", i)},
+				{"duration_ms", 180000 + i},
+				{"explicit", false},
+				{"is_playable", true},
+				{"popularity", 50},
+				{"track_number", i % 12 + 1},
+				{"uri", lib::fmt::format("spotify:track:{}", id)},
+				{"href", lib::fmt::format("https://api.spotify.com/v1/tracks/{}", id)},
+				{"artists", {
+					{
+						{"id", lib::fmt::format("artist{}", i / 10)},
+						{"name", lib::fmt::format("Artist {}", i / 10)},
+						{"type", "artist"},
+					},
+				}},
+				{"album", {
+					{"id", lib::fmt::format("album{}", i / 5)},
+					{"name", lib::fmt::format("Album {}", i / 5)},
+					{"release_date", "2020-01-01"},
+					{"images", {
+						{{"url", "https://i.scdn.co/image/large"}, {"width", 640}},
+						{{"url", "https://i.scdn.co/image/medium"}, {"width", 300}},
+						{{"url", "https://i.scdn.co/image/small"}, {"width", 64}},
+					}},
+				}},
+			}},
+		});
+	}
+
+	return nlohmann::json{
+		{"total", page_size},
+		{"items", items},
+		{"next", nullptr},
+	}.dump();
+}
+
+template<typename Json>
+static void bench_convert(const std::string &data)
+{
+	const auto json = Json::parse(data);
+	std::vector<lib::spt::track> tracks;
+	tracks.reserve(json.at("items").size());
+	for (const auto &item : json.at("items"))
+	{
+		tracks.push_back(item.template get<lib::spt::track>());
+	}
+	bench::keep(tracks);
+}
+
+static void bench_playlist_pages(size_t page_size)
+{
+	constexpr size_t iterations = 20;
+	const auto data = bench_playlist_page(page_size);
+
+	std::cout << "  " << page_size << " tracks, "
+		<< data.size() / 1024 << " kB" << std::endl;
+
+	const auto parse = [&data]()
+	{
+		bench::keep(nlohmann::json::parse(data));
+	};
+
+	const auto arena_parse = [&data]()
+	{
+		lib::arena arena(data.size() * 2);
+		lib::arena::scope scope(arena);
+		bench::keep(lib::arena_json::parse(data));
+	};
+
+	const auto convert = [&data]()
+	{
+		bench_convert<nlohmann::json>(data);
+	};
+
+	const auto arena_convert = [&data]()
+	{
+		lib::arena arena(data.size() * 2);
+		lib::arena::scope scope(arena);
+		bench_convert<lib::arena_json>(data);
+	};
+
+	bench::count_allocations("parse and destroy", parse);
+	bench::count_allocations("arena parse and destroy", arena_parse);
+	bench::measure("parse and destroy", iterations, parse);
+	bench::measure("arena parse and destroy", iterations, arena_parse);
+	bench::measure("parse, convert and destroy", iterations, convert);
+	bench::measure("arena parse, convert and destroy", iterations, arena_convert);
+}
+
+static bench::registrar arena_json("arena json", []()
+{
+	bench_playlist_pages(100);
+	bench_playlist_pages(10000);
+});
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+	/**
+	 * Registered benchmark
+	 */
+	class benchmark
+	{
+	public:
+		benchmark(const std::string &name, const std::function<void()> &run);
+
+		std::string name;
+		std::function<void()> run;
+	};
+
+	/**
+	 * All registered benchmarks
+	 */
+	auto all() -> std::vector<benchmark> &;
+
+	/**
+	 * Register benchmark when constructed, intended to be used as a static variable
+	 */
+	class registrar
+	{
+	public:
+		registrar(const std::string &name, const std::function<void()> &run);
+	};
+
+	/**
+	 * Run function a number of times, and print average time per iteration
+	 * @param name Name to print
+	 * @param iterations Number of times to run function
+	 * @param run Function to measure
+	 */
+	void measure(const std::string &name, size_t iterations,
+		const std::function<void()> &run);
+
+	/**
+	 * Run function once, and print number of heap allocations made while running
+	 * @param name Name to print
+	 * @param run Function to measure
+	 */
+	void count_allocations(const std::string &name, const std::function<void()> &run);
+
+	/**
+	 * Prevent compiler from optimizing away value
+	 */
+	template<typename T>
+	void keep(const T &value)
+	{
+		static volatile const void *sink;
+		sink = &value;
+		static_cast<void>(sink);
+	}
+}
@@ -0,0 +1,63 @@
+#include "bench.hpp"
+
+#include "lib/format.hpp"
+#include "lib/log.hpp"
+#include "lib/history/listeninghistory.hpp"
+
+static bench::registrar listening_stats("listening stats", []()
+{
+	constexpr size_t iterations = 10;
+	const ghc::filesystem::path path = "bench-history";
+
+	lib::log::set_log_to_stdout(false);
+	ghc::filesystem::remove_all(path);
+
+	// About 5 years of 50 plays per day, from 10 000 different tracks
+	constexpr size_t play_count = 5 * 365 * 50;
+	constexpr std::int64_t start = 1451606400; // 2016-01-01
+	{
+		lib::listening_history history(path);
+		for (size_t i = 0; i < play_count; i++)
+		{
+			lib::spt::track track;
+			track.id = lib::fmt::format("{}", 1000000000 + (i * 7919) % 10000);
+			track.name = lib::fmt::format("Track {}", track.id);
+			track.duration = 180000;
+			track.album.id = lib::fmt::format("album{}", (i * 7919) % 10000 / 10);
+			track.album.name = track.album.id;
+
+			lib::spt::entity artist;
+			artist.id = lib::fmt::format("artist{}", (i * 7919) % 10000 / 50);
+			artist.name = artist.id;
+			track.artists.push_back(artist);
+
+			history.add(track, start + static_cast<std::int64_t>(i) * 24 * 60 * 60 / 50);
+		}
+	}
+	std::cout << "  " << play_count << " plays" << std::endl;
+
+	bench::measure("rebuild from all plays", 1, [&path]()
+	{
+		ghc::filesystem::remove(path / "stats.json");
+		lib::listening_history history(path);
+		bench::keep(history.stats().plays());
+	});
+
+	bench::measure("load saved", iterations, [&path]()
+	{
+		lib::listening_history history(path);
+		bench::keep(history.stats().plays());
+	});
+
+	lib::listening_history history(path);
+	const auto &stats = history.stats();
+
+	bench::measure("top 50 tracks, artists and albums", iterations, [&stats]()
+	{
+		bench::keep(stats.top_tracks(50));
+		bench::keep(stats.top_artists(50));
+		bench::keep(stats.top_albums(50));
+	});
+
+	ghc::filesystem::remove_all(path);
+});
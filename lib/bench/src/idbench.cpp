@@ -0,0 +1,75 @@
+#include "bench.hpp"
+
+#include "lib/spotify/id.hpp"
+
+#include <random>
+#include <unordered_map>
+
+static bench::registrar spotify_id("spotify id", []()
+{
+	constexpr size_t count = 100000;
+	constexpr size_t iterations = 10;
+	const std::string alphabet = "0123456789"
+		"abcdefghijklmnopqrstuvwxyz"
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+	std::mt19937 random(1);
+	std::uniform_int_distribution<size_t> distribution(0, alphabet.size() - 1);
+
+	// First character is at most 7 to fit in 128 bits
+	std::vector<std::string> values;
+	values.reserve(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		std::string value(1, alphabet.at(distribution(random) % 8));
+		for (size_t j = 1; j < lib::spt::id::length; j++)
+		{
+			value += alphabet.at(distribution(random));
+		}
+		values.push_back(value);
+	}
+
+	std::vector<lib::spt::id> ids;
+	ids.reserve(count);
+
+	std::unordered_map<std::string, size_t> by_string;
+	std::unordered_map<lib::spt::id, size_t> by_id;
+	for (size_t i = 0; i < count; i++)
+	{
+		ids.emplace_back(values.at(i));
+		by_string[values.at(i)] = i;
+		by_id[ids.at(i)] = i;
+	}
+
+	std::cout << "  " << count << " ids, key size " << sizeof(std::string)
+		<< " + 23 bytes as string, " << sizeof(lib::spt::id) << " bytes packed"
+		<< std::endl;
+
+	bench::measure("parse", iterations, [&values]()
+	{
+		for (const auto &value : values)
+		{
+			bench::keep(lib::spt::id(value));
+		}
+	});
+
+	bench::measure("lookup by string", iterations, [&values, &by_string]()
+	{
+		size_t sum = 0;
+		for (const auto &value : values)
+		{
+			sum += by_string.at(value);
+		}
+		bench::keep(sum);
+	});
+
+	bench::measure("lookup by id", iterations, [&ids, &by_id]()
+	{
+		size_t sum = 0;
+		for (const auto &id : ids)
+		{
+			sum += by_id.at(id);
+		}
+		bench::keep(sum);
+	});
+});
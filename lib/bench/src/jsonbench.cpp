@@ -0,0 +1,64 @@
+#include "bench.hpp"
+
+#include "lib/json.hpp"
+#include "lib/cache/normalizedtracks.hpp"
+
+static auto bench_tracks(size_t count) -> std::vector<lib::spt::track>
+{
+	std::vector<lib::spt::track> tracks;
+	tracks.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		lib::spt::track track;
+		track.id = lib::fmt::format("{}", 1000000000 + i);
+		track.name = lib::fmt::format("Track {}", i);
+		track.duration = static_cast<int>(i);
+		track.added_at = "2021-01-01T00:00:00Z";
+		track.album.id = lib::fmt::format("album{}", i / 10);
+		track.album.name = lib::fmt::format("Album {}", i / 10);
+		track.image = lib::fmt::format("https://i.scdn.co/image/{}", i / 10);
+
+		lib::spt::entity artist;
+		artist.id = lib::fmt::format("artist{}", i / 50);
+		artist.name = lib::fmt::format("Artist {}", i / 50);
+		track.artists.push_back(artist);
+
+		tracks.push_back(track);
+	}
+
+	return tracks;
+}
+
+static void bench_load(const std::string &name, const nlohmann::json &json)
+{
+	constexpr size_t iterations = 10;
+	const ghc::filesystem::path path = "bench-load.json";
+
+	std::ofstream(path) << json.dump();
+	std::cout << "  " << name << ": "
+		<< ghc::filesystem::file_size(path) / 1024 << " kB" << std::endl;
+
+	bench::measure("stream (previous)", iterations, [&path]()
+	{
+		std::ifstream file(path);
+		nlohmann::json result;
+		file >> result;
+		bench::keep(result);
+	});
+
+	bench::measure("single read", iterations, [&path]()
+	{
+		bench::keep(lib::json::load(path));
+	});
+
+	ghc::filesystem::remove(path);
+}
+
+static bench::registrar json_load("json load", []()
+{
+	const auto tracks = bench_tracks(20000);
+
+	bench_load("array of tracks", tracks);
+	bench_load("normalized tracks", lib::normalized_tracks::to_json(tracks));
+});
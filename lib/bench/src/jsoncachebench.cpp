@@ -0,0 +1,60 @@
+#include "bench.hpp"
+
+#include "lib/cache/jsoncache.hpp"
+
+class bench_paths: public lib::paths
+{
+public:
+	~bench_paths()
+	{
+		ghc::filesystem::remove_all(cache());
+	}
+
+	auto config_file() const -> ghc::filesystem::path override
+	{
+		return "spotify-qt-bench.json";
+	}
+
+	auto cache() const -> ghc::filesystem::path override
+	{
+		return "cache-bench";
+	}
+};
+
+static bench::registrar json_cache_album("json_cache album lookup", []()
+{
+	constexpr size_t iterations = 100000;
+	const std::string url = "https://i.scdn.co/image/ab67616d00004851";
+	constexpr int size = 32;
+
+	bench_paths paths;
+	lib::json_cache cache(paths);
+	cache.set_album_image(url, size, std::vector<unsigned char>(1024));
+
+	bench::measure("resolved directory", iterations, [&]()
+	{
+		bench::keep(cache.get_album_image(url, size));
+	});
+
+	// What every lookup did before directories were resolved once
+	const auto dir = paths.cache() / "album";
+	bench::measure("exists per lookup (previous)", iterations, [&]()
+	{
+		if (!ghc::filesystem::exists(dir))
+		{
+			ghc::filesystem::create_directories(dir);
+		}
+		bench::keep(cache.get_album_image(url, size));
+	});
+
+	bench::measure("exists only", iterations, [&]()
+	{
+		bench::keep(ghc::filesystem::exists(dir));
+	});
+
+	// What every lookup did to get the file name, before
+	bench::measure("url id as path (previous)", iterations, [&]()
+	{
+		bench::keep(ghc::filesystem::path(url).stem().string());
+	});
+});
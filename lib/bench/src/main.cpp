@@ -0,0 +1,60 @@
+#include "bench.hpp"
+
+#include "lib/log.hpp"
+
+#include <chrono>
+#include <iostream>
+
+bench::benchmark::benchmark(const std::string &name, const std::function<void()> &run)
+	: name(name),
+	run(run)
+{
+}
+
+auto bench::all() -> std::vector<benchmark> &
+{
+	static std::vector<benchmark> benchmarks;
+	return benchmarks;
+}
+
+bench::registrar::registrar(const std::string &name, const std::function<void()> &run)
+{
+	all().emplace_back(name, run);
+}
+
+void bench::measure(const std::string &name, size_t iterations,
+	const std::function<void()> &run)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+	{
+		run();
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	const auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+	std::cout << "  " << name << ": "
+		<< total.count() / static_cast<long long>(iterations) << " ns/op"
+		<< " (" << iterations << " iterations)" << std::endl;
+}
+
+auto main(int argc, char **argv) -> int
+{
+	lib::log::set_log_to_stdout(false);
+
+	// Optional filter as first argument
+	const std::string filter = argc > 1 ? argv[1] : std::string();
+
+	for (const auto &benchmark : bench::all())
+	{
+		if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		std::cout << benchmark.name << std::endl;
+		benchmark.run();
+	}
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include "bench.hpp"
+
+#include "lib/format.hpp"
+#include "lib/stringpool.hpp"
+#include "lib/spotify/track.hpp"
+
+/**
+ * Library of playlists, where tracks are often in more than one playlist,
+ * and albums and artists have many tracks
+ */
+static auto bench_library(size_t count) -> std::vector<lib::spt::track>
+{
+	std::vector<lib::spt::track> tracks;
+	tracks.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		// About 1 in 5 tracks are unique
+		const auto unique = (i * 7919) % (count / 5);
+
+		lib::spt::track track;
+		track.id = lib::fmt::format("{}aBcDeFgHiJkLmN", 1000000 + unique);
+		track.name = lib::fmt::format("Track name number {}", unique);
+		track.duration = 180000;
+		track.added_at = lib::fmt::format("2021-01-{}T12:00:00Z", 10 + i % 20);
+		track.album.id = lib::fmt::format("{}oPqRsTuVwXyZaB", 1000000 + unique / 10);
+		track.album.name = lib::fmt::format("Album name number {}", unique / 10);
+		track.image = lib::fmt::format("https://i.scdn.co/image/ab67616d00004851{}abcdef",
+			100000000000000 + unique / 10);
+
+		lib::spt::entity artist;
+		artist.id = lib::fmt::format("{}cDeFgHiJkLmNoP", 1000000 + unique / 50);
+		artist.name = lib::fmt::format("Artist number {}", unique / 50);
+		track.artists.push_back(artist);
+
+		tracks.push_back(track);
+	}
+
+	return tracks;
+}
+
+/**
+ * Approximate memory used by a string, including heap allocation
+ */
+static auto string_size(const std::string &str) -> size_t
+{
+	// Short strings are stored inline
+	constexpr size_t inline_size = 15;
+	return sizeof(std::string) + (str.size() > inline_size ? str.capacity() + 1 : 0);
+}
+
+template<typename Fn>
+static void for_each_string(const std::vector<lib::spt::track> &tracks, Fn fn)
+{
+	for (const auto &track : tracks)
+	{
+		fn(track.id);
+		fn(track.name);
+		fn(track.added_at);
+		fn(track.album.id);
+		fn(track.album.name);
+		fn(track.image);
+		for (const auto &artist : track.artists)
+		{
+			fn(artist.id);
+			fn(artist.name);
+		}
+	}
+}
+
+static bench::registrar string_pool("string pool", []()
+{
+	for (const auto count : {10000, 100000})
+	{
+		const auto tracks = bench_library(static_cast<size_t>(count));
+		std::cout << "  " << count << " tracks" << std::endl;
+
+		size_t fields = 0;
+		size_t string_bytes = 0;
+		for_each_string(tracks, [&fields, &string_bytes](const std::string &str)
+		{
+			fields++;
+			string_bytes += string_size(str);
+		});
+
+		lib::string_pool pool;
+		for_each_string(tracks, [&pool](const std::string &str)
+		{
+			pool.intern(str);
+		});
+
+		// Each unique string is a node with the string, a hash and a next pointer
+		constexpr size_t node_size = sizeof(std::string) + 2 * sizeof(void *);
+		const auto pooled_bytes = fields * sizeof(lib::interned_string)
+			+ pool.size() * (node_size + sizeof(void *))
+			+ pool.bytes() + pool.size();
+
+		std::cout << "  std::string: " << string_bytes / 1024 << " kB" << std::endl
+			<< "  interned: " << pooled_bytes / 1024 << " kB ("
+			<< pool.size() << " unique of " << fields << ")" << std::endl;
+
+		bench::measure("intern all fields", 10, [&tracks]()
+		{
+			lib::string_pool pool;
+			for_each_string(tracks, [&pool](const std::string &str)
+			{
+				bench::keep(pool.intern(str));
+			});
+		});
+	}
+});
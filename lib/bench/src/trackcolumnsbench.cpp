@@ -0,0 +1,168 @@
+#include "bench.hpp"
+
+#include "lib/format.hpp"
+#include "lib/strings.hpp"
+#include "lib/listdiff.hpp"
+#include "lib/tracks/trackcolumns.hpp"
+#include "lib/tracks/trackdiff.hpp"
+#include "lib/tracks/trackfilter.hpp"
+#include "lib/tracks/tracksortkeys.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+static auto column_tracks(size_t count) -> std::vector<lib::spt::track>
+{
+	std::vector<lib::spt::track> tracks;
+	tracks.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto unique = (i * 7919) % count;
+
+		lib::spt::track track;
+		track.id = lib::fmt::format("{}aBcDeFgHiJkLmN", 1000000 + unique);
+		track.name = lib::fmt::format("Track name number {}", unique);
+		track.duration = static_cast<int>(unique % 600000);
+		track.added_at = lib::fmt::format("2021-{}-{}T12:00:00Z",
+			10 + unique % 3, 10 + unique % 19);
+		track.album.id = lib::fmt::format("{}oPqRsTuVwXyZaB", 1000000 + unique / 10);
+		track.album.name = lib::fmt::format("Album name number {}", unique / 10);
+		track.image = lib::fmt::format("https://i.scdn.co/image/ab67616d00004851{}abcdef",
+			100000000000000 + unique / 10);
+
+		lib::spt::entity artist;
+		artist.id = lib::fmt::format("{}cDeFgHiJkLmNoP", 1000000 + unique / 50);
+		artist.name = lib::fmt::format("Artist number {}", unique / 50);
+		track.artists.push_back(artist);
+
+		tracks.push_back(track);
+	}
+
+	return tracks;
+}
+
+static auto row_range(size_t count) -> std::vector<size_t>
+{
+	std::vector<size_t> rows(count);
+	std::iota(rows.begin(), rows.end(), 0);
+	return rows;
+}
+
+static bench::registrar track_columns("track columns", []()
+{
+	for (const auto count : {10000, 100000, 1000000})
+	{
+		const auto tracks = column_tracks(static_cast<size_t>(count));
+		const auto iterations = count >= 1000000 ? 1 : 10;
+		std::cout << "  " << count << " tracks" << std::endl;
+
+		bench::measure("build columns", 1, [&tracks]()
+		{
+			bench::keep(lib::track_columns(tracks));
+		});
+
+		const lib::track_columns columns(tracks);
+
+		bench::measure("sort length, columns", iterations, [&columns]()
+		{
+			bench::keep(columns.sort(lib::track_column::length, true));
+		});
+
+		bench::measure("sort added, columns", iterations, [&columns]()
+		{
+			bench::keep(columns.sort(lib::track_column::added, true));
+		});
+
+		bench::measure("sort title, columns", iterations, [&columns]()
+		{
+			bench::keep(columns.sort(lib::track_column::title, true));
+		});
+
+		bench::measure("build sort keys", iterations, [&columns]()
+		{
+			bench::keep(lib::track_sort_keys(columns));
+		});
+
+		const lib::track_sort_keys keys(columns);
+
+		bench::measure("sort title, sort keys", iterations, [&keys]()
+		{
+			bench::keep(keys.sort(lib::track_column::title, true));
+		});
+
+		bench::measure("sort artist descending, sort keys", iterations, [&keys]()
+		{
+			bench::keep(keys.sort(lib::track_column::artist, false));
+		});
+
+		bench::measure("build filter", iterations, [&columns]()
+		{
+			bench::keep(lib::track_filter(columns));
+		});
+
+		// 18 keystrokes, typing and then erasing "number 12"
+		bench::measure("filter while typing, 18 keys", iterations, [&columns]()
+		{
+			const std::string query("number 12");
+			lib::track_filter filter(columns);
+			std::vector<size_t> rows;
+
+			for (size_t i = 1; i <= query.size(); i++)
+			{
+				rows = filter.filter(query.substr(0, i));
+			}
+			for (size_t i = query.size(); i > 0; i--)
+			{
+				rows = filter.filter(query.substr(0, i - 1));
+			}
+			bench::keep(rows);
+		});
+
+		bench::measure("diff, unchanged", iterations, [&tracks]()
+		{
+			const lib::track_diff diff(tracks, tracks);
+			bench::keep(lib::list_diff(diff.keys(row_range(tracks.size())),
+				row_range(tracks.size())));
+		});
+
+		// Every 1000th track removed, and one added at the start
+		auto changed = tracks;
+		for (auto i = changed.size(); i >= 1000; i -= 1000)
+		{
+			changed.erase(changed.begin() + static_cast<long>(i - 1000));
+		}
+		changed.insert(changed.begin(), tracks.back());
+		changed.front().id = "new";
+
+		bench::measure("diff, few changes", iterations, [&tracks, &changed]()
+		{
+			const lib::track_diff diff(tracks, changed);
+			bench::keep(lib::list_diff(diff.keys(row_range(tracks.size())),
+				row_range(changed.size())));
+		});
+
+		bench::measure("sort length, tracks (previous)", iterations, [&tracks]()
+		{
+			auto sorted = tracks;
+			std::stable_sort(sorted.begin(), sorted.end(),
+				[](const lib::spt::track &track1, const lib::spt::track &track2) -> bool
+				{
+					return track1.duration < track2.duration;
+				});
+			bench::keep(sorted);
+		});
+
+		bench::measure("sort title, tracks (previous)", iterations, [&tracks]()
+		{
+			auto sorted = tracks;
+			std::stable_sort(sorted.begin(), sorted.end(),
+				[](const lib::spt::track &track1, const lib::spt::track &track2) -> bool
+				{
+					return lib::strings::to_lower(track1.name)
+						< lib::strings::to_lower(track2.name);
+				});
+			bench::keep(sorted);
+		});
+	}
+});
@@ -0,0 +1,52 @@
+#include "clipaths.hpp"
+
+#include <cstdlib>
+
+cli_paths::cli_paths(const std::string &cache_dir)
+{
+#if defined(_WIN32)
+	const auto app_data = ghc::filesystem::path(env("LOCALAPPDATA")) / "kraxarn";
+	config_path = app_data / "spotify-qt.json";
+	cache_path = app_data / "spotify-qt" / "cache";
+#elif defined(__APPLE__)
+	const auto library = ghc::filesystem::path(env("HOME")) / "Library";
+	config_path = library / "Preferences" / "kraxarn" / "spotify-qt.json";
+	cache_path = library / "Caches" / "kraxarn" / "spotify-qt";
+#else
+	const auto home = ghc::filesystem::path(env("HOME"));
+	config_path = env("XDG_CONFIG_HOME", home / ".config") / "kraxarn" / "spotify-qt.json";
+	cache_path = env("XDG_CACHE_HOME", home / ".cache") / "kraxarn" / "spotify-qt";
+#endif
+
+	if (!cache_dir.empty())
+	{
+		cache_path = cache_dir;
+	}
+}
+
+auto cli_paths::config_file() const -> ghc::filesystem::path
+{
+	return config_path;
+}
+
+auto cli_paths::cache() const -> ghc::filesystem::path
+{
+	return cache_path;
+}
+
+auto cli_paths::env(const char *name) -> std::string
+{
+	const auto *value = std::getenv(name);
+	return value == nullptr
+		? std::string()
+		: std::string(value);
+}
+
+auto cli_paths::env(const char *name,
+	const ghc::filesystem::path &fallback) -> ghc::filesystem::path
+{
+	const auto value = env(name);
+	return value.empty()
+		? fallback
+		: ghc::filesystem::path(value);
+}
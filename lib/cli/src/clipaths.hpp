@@ -0,0 +1,33 @@
+#pragma once
+
+#include "lib/paths/paths.hpp"
+
+/**
+ * Same paths as QStandardPaths uses for spotify-qt, without depending on Qt
+ */
+class cli_paths: public lib::paths
+{
+public:
+	/**
+	 * @param cache_dir Cache directory to use instead of default, if not empty
+	 */
+	explicit cli_paths(const std::string &cache_dir);
+
+	auto config_file() const -> ghc::filesystem::path override;
+	auto cache() const -> ghc::filesystem::path override;
+
+private:
+	ghc::filesystem::path config_path;
+	ghc::filesystem::path cache_path;
+
+	/**
+	 * Get environment variable, or an empty string if not set
+	 */
+	static auto env(const char *name) -> std::string;
+
+	/**
+	 * Get environment variable, or fallback if not set
+	 */
+	static auto env(const char *name,
+		const ghc::filesystem::path &fallback) -> ghc::filesystem::path;
+};
@@ -0,0 +1,128 @@
+#include "clipaths.hpp"
+
+#include "lib/cache/jsoncache.hpp"
+#include "lib/format.hpp"
+#include "lib/log.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+	void usage()
+	{
+		std::cout << "Usage: spotify-qt-cache [--cache <path>] <command>" << std::endl
+			<< std::endl
+			<< "Commands:" << std::endl
+			<< "  stats    Show number of files and size of each type" << std::endl
+			<< "  verify   Check files, without changing anything" << std::endl
+			<< "  compact  Remove invalid and unused files," << std::endl
+			<< "           and rewrite files saved by older versions" << std::endl;
+	}
+
+	void print_usage(const std::string &type, const lib::cache_usage &usage)
+	{
+		std::cout << std::left << std::setw(12) << type
+			<< std::right << std::setw(8) << usage.count << " files"
+			<< std::setw(12) << lib::fmt::size(usage.size)
+			<< std::endl;
+	}
+
+	auto stats(lib::json_cache &cache) -> int
+	{
+		lib::cache_usage total;
+
+		for (const auto &usage : cache.get_usage())
+		{
+			print_usage(usage.first, usage.second);
+			total.count += usage.second.count;
+			total.size += usage.second.size;
+		}
+
+		print_usage("total", total);
+		return 0;
+	}
+
+	auto verify(lib::json_cache &cache, bool repair) -> size_t
+	{
+		const auto issues = cache.verify(repair);
+		for (const auto &issue : issues)
+		{
+			std::cout << issue.type << "/" << issue.name
+				<< ": " << issue.reason << std::endl;
+		}
+
+		std::cout << issues.size()
+			<< (repair ? " files removed" : " invalid or unused files")
+			<< std::endl;
+
+		return issues.size();
+	}
+
+	auto compact(lib::json_cache &cache) -> int
+	{
+		verify(cache, true);
+		std::cout << cache.compact() << " files rewritten" << std::endl
+			<< std::endl;
+
+		return stats(cache);
+	}
+}
+
+auto main(int argc, char **argv) -> int
+{
+	std::string cache_dir;
+	std::string command;
+
+	for (auto i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--cache" && i + 1 < argc)
+		{
+			cache_dir = argv[++i];
+		}
+		else if (arg == "--help" || arg == "-h")
+		{
+			usage();
+			return 0;
+		}
+		else
+		{
+			command = arg;
+		}
+	}
+
+	if (command.empty())
+	{
+		usage();
+		return 1;
+	}
+
+	cli_paths paths(cache_dir);
+	if (!ghc::filesystem::is_directory(paths.cache()))
+	{
+		std::cerr << "No cache found in " << paths.cache().string() << std::endl;
+		return 1;
+	}
+
+	// Warnings are already shown as issues
+	lib::log::set_log_to_stdout(false);
+	// Only compact is allowed to change anything
+	lib::json_cache cache(paths, command != "compact");
+
+	if (command == "stats")
+	{
+		return stats(cache);
+	}
+	if (command == "verify")
+	{
+		return verify(cache, false) > 0 ? 1 : 0;
+	}
+	if (command == "compact")
+	{
+		return compact(cache);
+	}
+
+	usage();
+	return 1;
+}
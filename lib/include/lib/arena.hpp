@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Monotonic memory arena, memory is only freed when the arena is destroyed
+	 * @note Not safe to use from multiple threads
+	 */
+	class arena
+	{
+	public:
+		/**
+		 * @param block_size Size of first block, later blocks grow up to max_block_size
+		 */
+		explicit arena(size_t block_size = default_block_size);
+
+		arena(const arena &) = delete;
+		auto operator=(const arena &) -> arena & = delete;
+
+		/**
+		 * Allocate memory that is valid until the arena is destroyed
+		 */
+		auto allocate(size_t size, size_t alignment) -> void *;
+
+		/**
+		 * Bytes reserved in all blocks
+		 */
+		auto capacity() const -> size_t;
+
+		/**
+		 * Bytes handed out from all blocks, including alignment padding
+		 */
+		auto used() const -> size_t;
+
+		/**
+		 * Arena used by arena_allocator on this thread, or nullptr if none
+		 */
+		static auto current() -> arena *;
+
+		/**
+		 * Makes an arena current on this thread while in scope
+		 * @note Anything allocated from the arena must be destroyed before the scope ends
+		 */
+		class scope
+		{
+		public:
+			explicit scope(arena &arena);
+			~scope();
+
+			scope(const scope &) = delete;
+			auto operator=(const scope &) -> scope & = delete;
+
+		private:
+			arena *previous;
+		};
+
+		static constexpr size_t default_block_size = 64 * 1024;
+		static constexpr size_t max_block_size = 1024 * 1024;
+
+	private:
+		std::vector<std::unique_ptr<char[]>> blocks;
+		size_t next_block_size;
+
+		/**
+		 * Size of, and bytes used in, last block
+		 */
+		size_t block_size = 0;
+		size_t block_used = 0;
+
+		/**
+		 * Totals of all blocks before the last one
+		 */
+		size_t previous_capacity = 0;
+		size_t previous_used = 0;
+
+		/**
+		 * Allocate from last block, or nullptr if it doesn't fit
+		 */
+		auto allocate_in_block(size_t size, size_t alignment) -> void *;
+
+		/**
+		 * Add a new block with room for at least size bytes
+		 */
+		void add_block(size_t size);
+	};
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "lib/arena.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace lib
+{
+	/**
+	 * Allocator using the current arena on this thread, or the heap if there is none
+	 * @note Memory is only given back to the heap if no arena is current
+	 * when deallocating, so containers must be destroyed in the same
+	 * lib::arena::scope they were filled in
+	 */
+	template<typename T>
+	class arena_allocator
+	{
+	public:
+		using value_type = T;
+
+		arena_allocator() noexcept = default;
+
+		template<typename U>
+		arena_allocator(const arena_allocator<U> &/*other*/) noexcept
+		{
+		}
+
+		auto allocate(size_t count) -> T *
+		{
+			auto *arena = lib::arena::current();
+			if (arena == nullptr)
+			{
+				return std::allocator<T>().allocate(count);
+			}
+			return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T *ptr, size_t count) noexcept
+		{
+			if (lib::arena::current() == nullptr)
+			{
+				std::allocator<T>().deallocate(ptr, count);
+			}
+		}
+
+		template<typename U>
+		struct rebind
+		{
+			using other = arena_allocator<U>;
+		};
+	};
+
+	template<typename T, typename U>
+	auto operator==(const arena_allocator<T> &/*a*/, const arena_allocator<U> &/*b*/) -> bool
+	{
+		return true;
+	}
+
+	template<typename T, typename U>
+	auto operator!=(const arena_allocator<T> &/*a*/, const arena_allocator<U> &/*b*/) -> bool
+	{
+		return false;
+	}
+}
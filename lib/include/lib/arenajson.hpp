@@ -0,0 +1,22 @@
+#pragma once
+
+#include "lib/arenaallocator.hpp"
+
+#include "thirdparty/json.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * JSON where objects, arrays and values are allocated with arena_allocator,
+	 * intended for parsing a response that is converted and thrown away at once
+	 * @note Strings longer than the small string buffer are still on the heap,
+	 * as models expect std::string
+	 */
+	using arena_json = nlohmann::basic_json<std::map, std::vector, std::string,
+		bool, std::int64_t, std::uint64_t, double, lib::arena_allocator>;
+}
@@ -7,6 +7,11 @@
 #include "lib/spotify/album.hpp"
 #include "lib/spotify/trackinfo.hpp"
 #include "lib/crash/crashinfo.hpp"
+#include "lib/cache/cacheusage.hpp"
+#include "lib/cache/cachewrites.hpp"
+
+#include <functional>
+#include <map>
 
 namespace lib
 {
@@ -39,6 +44,24 @@ namespace lib
 		virtual void set_album_image(const std::string &url,
 			const std::vector<unsigned char> &data) = 0;
 
+		/**
+		 * Get pre-scaled album image data
+		 * @param url URL to album image
+		 * @param size Width and height of scaled image
+		 * @return Binary JPEG data, or an empty vector if none
+		 */
+		virtual auto get_album_image(const std::string &url, int size) const
+		-> std::vector<unsigned char> = 0;
+
+		/**
+		 * Set pre-scaled album image data
+		 * @param url URL to album image
+		 * @param size Width and height of scaled image
+		 * @param data Binary JPEG data to save
+		 */
+		virtual void set_album_image(const std::string &url, int size,
+			const std::vector<unsigned char> &data) = 0;
+
 		//endregion
 
 		//region playlists
@@ -90,10 +113,11 @@ namespace lib
 			const std::vector<lib::spt::track> &tracks) = 0;
 
 		/**
-		 * Get all tracks saved in cache
-		 * @return Map as id: tracks
+		 * Iterate through all tracks saved in cache, loading one entry at a time
+		 * @param callback Id and tracks of entry, return false to stop iterating
 		 */
-		virtual auto all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>> = 0;
+		virtual void all_tracks(const std::function<bool(const std::string &id,
+			const std::vector<lib::spt::track> &tracks)> &callback) const = 0;
 
 		//endregion
 
@@ -131,5 +155,21 @@ namespace lib
 		virtual auto get_all_crashes() const -> std::vector<lib::crash_info> = 0;
 
 		//endregion
+
+		//region usage
+
+		/**
+		 * Get number of files and total size of each cache type
+		 * @return Map as type: usage
+		 */
+		virtual auto get_usage() const -> std::map<std::string, lib::cache_usage> = 0;
+
+		/**
+		 * Get number of writes done, and skipped as content was unchanged,
+		 * since cache was created
+		 */
+		virtual auto get_writes() const -> lib::cache_writes = 0;
+
+		//endregion
 	};
 }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "lib/cache.hpp"
+#include "lib/tracks/trackcolumns.hpp"
+
+namespace lib
+{
+	/**
+	 * All tracks saved in cache, loaded as columns
+	 * @note Tracks are often saved in more than one list, so strings are
+	 * interned while loading, and each unique name is only stored once
+	 */
+	class cached_tracks
+	{
+	public:
+		/**
+		 * Load tracks from all lists in cache, one list at a time
+		 */
+		static auto load(const lib::cache &cache) -> lib::track_columns;
+
+	private:
+		/**
+		 * Static class
+		 */
+		cached_tracks() = default;
+	};
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "thirdparty/json.hpp"
+
+#include <cstdint>
+
+namespace lib
+{
+	/**
+	 * Single file in the cache manifest
+	 */
+	class cache_entry
+	{
+	public:
+		cache_entry() = default;
+
+		/**
+		 * Size of file in bytes
+		 */
+		size_t size = 0;
+
+		/**
+		 * Seconds since epoch when entry was last read or written
+		 */
+		long last_access = 0;
+
+		/**
+		 * Hash of content, or 0 if unknown
+		 */
+		std::uint64_t hash = 0;
+
+		/**
+		 * Hash of model before it was serialized, or 0 if unknown
+		 */
+		std::uint64_t content_hash = 0;
+
+		/**
+		 * Schema version entry was written with, or 0 if unknown
+		 */
+		int version = 0;
+	};
+
+	/**
+	 * cache_entry -> json
+	 */
+	void to_json(nlohmann::json &j, const cache_entry &e);
+
+	/**
+	 * json -> cache_entry
+	 */
+	void from_json(const nlohmann::json &j, cache_entry &e);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+
+namespace lib
+{
+	/**
+	 * File in cache that is invalid or unused
+	 */
+	class cache_issue
+	{
+	public:
+		cache_issue() = default;
+
+		cache_issue(std::string type, std::string name, std::string reason)
+			: type(std::move(type)),
+			name(std::move(name)),
+			reason(std::move(reason))
+		{
+		}
+
+		/**
+		 * Cache type, for example "album"
+		 */
+		std::string type;
+
+		/**
+		 * File name, including extension
+		 */
+		std::string name;
+
+		/**
+		 * Why file is invalid or unused
+		 */
+		std::string reason;
+	};
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "lib/cache/cacheentry.hpp"
+#include "lib/cache/cacheusage.hpp"
+#include "thirdparty/filesystem.hpp"
+#include "thirdparty/json.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Index of all files in the cache, kept up to date on every write
+	 * @note Changes are appended to a journal, and merged into the
+	 * manifest when saved, or when the journal grows too large
+	 */
+	class cache_manifest
+	{
+	public:
+		/**
+		 * Load manifest, or rebuild it from existing files if missing
+		 * @param dir Root cache directory
+		 * @param types Sub-directories managed by the manifest
+		 * @param read_only Never write manifest or journal to disk
+		 */
+		cache_manifest(const ghc::filesystem::path &dir,
+			const std::vector<std::string> &types, bool read_only = false);
+
+		/**
+		 * Saves manifest if changed
+		 */
+		~cache_manifest();
+
+		/**
+		 * Entry was written
+		 * @param type Cache type, for example "tracks"
+		 * @param name File name, including extension
+		 * @param size New size in bytes
+		 * @param hash Hash of new content
+		 * @param version Schema version content was written with
+		 * @param content_hash Hash of model content was serialized from
+		 */
+		void update(const std::string &type, const std::string &name,
+			size_t size, std::uint64_t hash, int version,
+			std::uint64_t content_hash = 0);
+
+		/**
+		 * Entry was deleted
+		 */
+		void remove(const std::string &type, const std::string &name);
+
+		/**
+		 * Entry was read
+		 */
+		void touch(const std::string &type, const std::string &name);
+
+		/**
+		 * Get entry
+		 * @param entry Entry to set if found
+		 * @return Entry is in cache
+		 */
+		auto get(const std::string &type, const std::string &name,
+			cache_entry &entry) const -> bool;
+
+		/**
+		 * File names of all entries of a type
+		 */
+		auto names(const std::string &type) const -> std::vector<std::string>;
+
+		/**
+		 * Total usage of a type
+		 */
+		auto usage(const std::string &type) const -> cache_usage;
+
+		/**
+		 * Total usage of all types
+		 */
+		auto usage() const -> std::map<std::string, cache_usage>;
+
+		/**
+		 * Entries to remove, least recently used first, to fit in size
+		 * @param type Cache type
+		 * @param max_size Maximum total size in bytes
+		 * @return File names
+		 */
+		auto least_recently_used(const std::string &type,
+			size_t max_size) const -> std::vector<std::string>;
+
+		/**
+		 * Save full manifest and clear journal
+		 */
+		void save();
+
+	private:
+		/**
+		 * Current manifest format, older manifests are rebuilt
+		 */
+		static constexpr int manifest_version = 1;
+
+		/**
+		 * Merge journal into manifest after this many changes
+		 */
+		static constexpr int max_journal_size = 1000;
+
+		ghc::filesystem::path dir;
+		std::vector<std::string> types;
+		bool read_only;
+
+		std::map<std::string, std::map<std::string, cache_entry>> entries;
+		std::map<std::string, cache_usage> usages;
+
+		bool changed = false;
+		int journal_size = 0;
+
+		/**
+		 * Cache can be read from background threads
+		 */
+		mutable std::mutex mutex;
+
+		auto manifest_path() const -> ghc::filesystem::path;
+		auto journal_path() const -> ghc::filesystem::path;
+
+		/**
+		 * Load manifest and journal from disk
+		 * @return If successful and up to date
+		 */
+		auto load() -> bool;
+
+		/**
+		 * Rebuild manifest from all files in cache
+		 */
+		void rebuild();
+
+		/**
+		 * Set entry without writing to journal
+		 */
+		void set(const std::string &type, const std::string &name,
+			const cache_entry &entry);
+
+		/**
+		 * Remove entry without writing to journal
+		 */
+		void unset(const std::string &type, const std::string &name);
+
+		/**
+		 * Append change to journal
+		 */
+		void journal(const nlohmann::json &json);
+
+		/**
+		 * Write full manifest and clear journal, without locking
+		 */
+		void write();
+	};
+}
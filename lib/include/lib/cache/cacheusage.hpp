@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace lib
+{
+	/**
+	 * Total usage of a type of cache
+	 */
+	class cache_usage
+	{
+	public:
+		cache_usage() = default;
+
+		/**
+		 * Number of files
+		 */
+		size_t count = 0;
+
+		/**
+		 * Total size of all files in bytes
+		 */
+		size_t size = 0;
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "lib/cache.hpp"
+#include "lib/spotify/playlist.hpp"
+#include "lib/spotify/track.hpp"
+
+#include <future>
+#include <string>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Loads what's needed at startup from cache on background threads
+	 */
+	class cache_warm_up
+	{
+	public:
+		/**
+		 * Start loading from cache
+		 * @param cache Cache to load from, needs to outlive warm-up
+		 * @param last_playlist ID of last opened playlist, or empty if none
+		 */
+		cache_warm_up(const lib::cache &cache, const std::string &last_playlist);
+
+		/**
+		 * Wait until everything is loaded
+		 * @note Call from a background thread, to get results without blocking
+		 */
+		void wait() const;
+
+		/**
+		 * All playlists, waits until loaded
+		 */
+		auto playlists() const -> std::vector<lib::spt::playlist>;
+
+		/**
+		 * Last opened playlist, with tracks, waits until loaded
+		 */
+		auto last_playlist() const -> lib::spt::playlist;
+
+		/**
+		 * Liked tracks, waits until loaded
+		 */
+		auto liked_tracks() const -> std::vector<lib::spt::track>;
+
+		/**
+		 * ID of liked tracks in cache
+		 */
+		static constexpr const char *liked_tracks_id = "liked_tracks";
+
+	private:
+		std::shared_future<std::vector<lib::spt::playlist>> playlists_future;
+		std::shared_future<lib::spt::playlist> last_playlist_future;
+		std::shared_future<std::vector<lib::spt::track>> liked_tracks_future;
+	};
+}
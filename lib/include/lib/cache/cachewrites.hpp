@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace lib
+{
+	/**
+	 * Number of writes done to cache
+	 */
+	class cache_writes
+	{
+	public:
+		cache_writes() = default;
+
+		/**
+		 * Files written
+		 */
+		size_t written = 0;
+
+		/**
+		 * Writes skipped as content was unchanged
+		 */
+		size_t skipped = 0;
+	};
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "lib/hash.hpp"
+#include "lib/spotify/playlist.hpp"
+#include "lib/spotify/track.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Hash of cached models, without serializing them first
+	 */
+	class content_hash
+	{
+	public:
+		/**
+		 * Hash of a list of tracks
+		 */
+		static auto get(const std::vector<lib::spt::track> &tracks) -> std::uint64_t;
+
+		/**
+		 * Hash of a playlist, including tracks
+		 */
+		static auto get(const lib::spt::playlist &playlist) -> std::uint64_t;
+
+		/**
+		 * Hash of a list of playlists, including tracks
+		 */
+		static auto get(const std::vector<lib::spt::playlist> &playlists) -> std::uint64_t;
+
+	private:
+		/**
+		 * Static class
+		 */
+		content_hash() = default;
+
+		static auto add(std::uint64_t hash, const std::string &value) -> std::uint64_t;
+		static auto add(std::uint64_t hash, size_t value) -> std::uint64_t;
+		static auto add(std::uint64_t hash, const lib::spt::entity &entity) -> std::uint64_t;
+		static auto add(std::uint64_t hash, const lib::spt::track &track) -> std::uint64_t;
+		static auto add(std::uint64_t hash, const lib::spt::playlist &playlist) -> std::uint64_t;
+	};
+}
@@ -1,28 +1,47 @@
 #pragma once
 
 #include "lib/cache.hpp"
+#include "lib/cache/cacheissue.hpp"
+#include "lib/cache/cachemanifest.hpp"
+#include "lib/cache/contenthash.hpp"
+#include "lib/cache/normalizedtracks.hpp"
+#include "lib/hash.hpp"
 #include "lib/json.hpp"
 #include "lib/paths/paths.hpp"
 #include "thirdparty/filesystem.hpp"
 #include "thirdparty/json.hpp"
 
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+
 namespace lib
 {
 	/**
 	 * Cache as JSON files
+	 * @note Safe to use from multiple threads, files are replaced atomically
 	 */
 	class json_cache: public cache
 	{
 	public:
 		/**
-		 * Instance a new json cache manager, does not create any directories
+		 * Instance a new json cache manager, and create cache directories if needed
 		 * @param paths Paths to get cache directory
+		 * @param read_only Only inspect existing files, without creating directories
+		 * or saving the manifest
 		 */
-		explicit json_cache(const paths &paths);
+		explicit json_cache(const paths &paths, bool read_only = false);
 
 		auto get_album_image(const std::string &url) const -> std::vector<unsigned char> override;
 		void set_album_image(const std::string &url,
 			const std::vector<unsigned char> &data) override;
+		auto get_album_image(const std::string &url, int size) const
+		-> std::vector<unsigned char> override;
+		void set_album_image(const std::string &url, int size,
+			const std::vector<unsigned char> &data) override;
 
 		auto get_playlists() const -> std::vector<lib::spt::playlist> override;
 		void set_playlists(const std::vector<spt::playlist> &playlists) override;
@@ -33,7 +52,8 @@ namespace lib
 		auto get_tracks(const std::string &id) const -> std::vector<lib::spt::track> override;
 		void set_tracks(const std::string &id,
 			const std::vector<lib::spt::track> &tracks) override;
-		auto all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>> override;
+		void all_tracks(const std::function<bool(const std::string &id,
+			const std::vector<lib::spt::track> &tracks)> &callback) const override;
 
 		auto get_track_info(const lib::spt::track &track) const -> lib::spt::track_info override;
 		void set_track_info(const lib::spt::track &track,
@@ -42,13 +62,81 @@ namespace lib
 		void add_crash(const lib::crash_info &info) override;
 		auto get_all_crashes() const -> std::vector<lib::crash_info> override;
 
+		auto get_usage() const -> std::map<std::string, lib::cache_usage> override;
+		auto get_writes() const -> lib::cache_writes override;
+
+		/**
+		 * Remove least recently used files until type fits in size
+		 * @param type Cache type, for example "album"
+		 * @param max_size Maximum size in bytes
+		 * @return Number of removed files
+		 */
+		auto evict(const std::string &type, size_t max_size) -> size_t;
+
+		/**
+		 * Find files that are invalid, or album images not used by any cached track
+		 * @param repair Remove found files, and manifest entries without files
+		 * @return Found files
+		 * @note Should not be used while cache is used by another process
+		 */
+		auto verify(bool repair) -> std::vector<lib::cache_issue>;
+
+		/**
+		 * Rewrite files saved with an older schema version
+		 * @return Number of rewritten files
+		 */
+		auto compact() -> size_t;
+
 	private:
+		/**
+		 * Current version of data written to cache
+		 */
+		static constexpr int schema_version = 3;
+
 		const lib::paths &paths;
+		mutable lib::cache_manifest manifest;
+
+		/**
+		 * Directory of each cache type, resolved once
+		 */
+		std::map<std::string, ghc::filesystem::path> dirs;
+
+		/**
+		 * Locks for writing files, selected by hash of file name
+		 */
+		mutable std::array<std::mutex, 16> write_locks;
+
+		std::atomic<size_t> written;
+		std::atomic<size_t> skipped;
+
+		/**
+		 * All cache types, as sub-directories of cache directory
+		 */
+		static auto types() -> const std::vector<std::string> &;
 
 		/**
 		 * Get parent directory for cache type
 		 */
-		auto dir(const std::string &type) const -> ghc::filesystem::path;
+		auto dir(const std::string &type) const -> const ghc::filesystem::path &;
+
+		/**
+		 * Open file for writing, creating directory again if it was removed
+		 */
+		auto open_write(const std::string &type, const std::string &name,
+			std::ios::openmode mode = std::ios::out) const -> std::ofstream;
+
+		/**
+		 * Names of all files in directory for cache type
+		 */
+		auto file_names(const std::string &type) const -> std::vector<std::string>;
+
+		/**
+		 * Check if file is valid
+		 * @param album_ids Add album images used by file
+		 * @return Reason file is invalid, or empty if valid
+		 */
+		auto verify_file(const std::string &type, const std::string &name,
+			std::unordered_set<std::string> &album_ids) const -> std::string;
 
 		/**
 		 * Get file name for id
@@ -56,14 +144,70 @@ namespace lib
 		static auto file(const std::string &id, const std::string &extension) -> std::string;
 
 		/**
-		 * Get full file path for cache type and id
+		 * Load JSON for cache type and id
+		 * @return JSON, or null object if not found
+		 */
+		auto load_json(const std::string &type, const std::string &id) const -> nlohmann::json;
+
+		/**
+		 * Save JSON for cache type and id, and update manifest
+		 */
+		void save_json(const std::string &type, const std::string &id,
+			const nlohmann::json &json);
+
+		/**
+		 * Save JSON for cache type and id, unless content is unchanged
+		 * @param content_hash Hash of model JSON is created from
+		 * @param get_json Get JSON to save, only called if content changed
+		 */
+		void save_json(const std::string &type, const std::string &id,
+			std::uint64_t content_hash, const std::function<nlohmann::json()> &get_json);
+
+		/**
+		 * Write JSON to file, and update manifest
+		 * @note Write lock for file must be held
+		 */
+		void write_json(const std::string &type, const std::string &name,
+			const nlohmann::json &json, std::uint64_t content_hash);
+
+		/**
+		 * File was already written with same content hash,
+		 * counts the write as skipped if so
+		 * @note Write lock for file must be held
+		 */
+		auto is_unchanged(const std::string &type, const std::string &name,
+			std::uint64_t content_hash) -> bool;
+
+		/**
+		 * Read binary file for cache type and name
+		 * @return Data, or an empty vector if not found
+		 */
+		auto read_binary(const std::string &type,
+			const std::string &name) const -> std::vector<unsigned char>;
+
+		/**
+		 * Write binary file for cache type and name, and update manifest
+		 */
+		void write_binary(const std::string &type, const std::string &name,
+			const std::vector<unsigned char> &data);
+
+		/**
+		 * Replace file with data
+		 * @note Write lock for file must be held
+		 * @return File was written
+		 */
+		auto write_file(const std::string &type, const std::string &name,
+			const char *data, size_t size) const -> bool;
+
+		/**
+		 * Lock for writing to file, shared by all files with the same hash
 		 */
-		auto path(const std::string &type, const std::string &id,
-			const std::string &extension) const -> ghc::filesystem::path;
+		auto write_lock(const std::string &type,
+			const std::string &name) const -> std::mutex &;
 
 		/**
-		 * Get basename of path
+		 * Get basename of url, without extension
 		 */
-		static auto get_url_id(const ghc::filesystem::path &path) -> std::string;
+		static auto get_url_id(const std::string &url) -> std::string;
 	};
 }
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "lib/spotify/track.hpp"
+#include "thirdparty/json.hpp"
+
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Track list stored with shared artist and album tables,
+	 * where tracks refer to entities by index, so each entity is only stored once
+	 */
+	class normalized_tracks
+	{
+	public:
+		/**
+		 * Tracks -> normalized JSON
+		 */
+		static auto to_json(const std::vector<lib::spt::track> &tracks) -> nlohmann::json;
+
+		/**
+		 * Normalized, or array of, JSON -> tracks
+		 * @return Tracks, or an empty vector if invalid
+		 */
+		static auto from_json(const nlohmann::json &json) -> std::vector<lib::spt::track>;
+
+		/**
+		 * JSON is in normalized format
+		 */
+		static auto is_normalized(const nlohmann::json &json) -> bool;
+
+	private:
+		/**
+		 * Static class
+		 */
+		normalized_tracks() = default;
+	};
+}
@@ -58,6 +58,16 @@ namespace lib
 		 */
 		static auto seconds_since_epoch() -> long;
 
+		/**
+		 * Date and time from seconds since 1970-01-01, in UTC
+		 */
+		static auto from_seconds_since_epoch(long long seconds) -> date_time;
+
+		/**
+		 * Seconds since 1970-01-01, assuming date and time is in UTC
+		 */
+		auto to_seconds_since_epoch() const -> long long;
+
 		/**
 		 * If the current instance represents a valid date
 		 * @return Date is valid
@@ -131,6 +141,12 @@ namespace lib
 		 */
 		void parse(const std::string &value, const char *format);
 
+		/**
+		 * Parse "yyyy-MM-ddTHH:mm:ssZ" without going through a stream
+		 * @return Date could be parsed
+		 */
+		auto parse_iso_date_time(const std::string &value) -> bool;
+
 		/**
 		 * Format a date as a string using the specified to_string
 		 * @param format Format to use
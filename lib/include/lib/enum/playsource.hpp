@@ -0,0 +1,20 @@
+#pragma once
+
+namespace lib
+{
+	/**
+	 * Where a play in listening history came from
+	 */
+	enum class play_source
+	{
+		/**
+		 * Recently played tracks from Spotify, time is when track stopped playing
+		 */
+		finished = 0,
+
+		/**
+		 * Seen playing in the client, time is when track started playing
+		 */
+		started = 1,
+	};
+}
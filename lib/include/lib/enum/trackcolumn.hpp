@@ -0,0 +1,29 @@
+#pragma once
+
+namespace lib
+{
+	/**
+	 * Column in a track list
+	 */
+	enum class track_column
+	{
+		/**
+		 * Original order
+		 */
+		index = 0,
+
+		title = 1,
+		artist = 2,
+		album = 3,
+
+		/**
+		 * Duration
+		 */
+		length = 4,
+
+		/**
+		 * When added to playlist or library
+		 */
+		added = 5,
+	};
+}
@@ -5,6 +5,7 @@
 #include "thirdparty/json.hpp"
 #include "thirdparty/filesystem.hpp"
 
+#include <cstdint>
 #include <string>
 
 namespace lib
@@ -49,7 +50,7 @@ namespace lib
 		 * Format size as B, kB, MB or GB (bytes)
 		 * @param bytes Bytes
 		 */
-		static std::string size(unsigned int bytes);
+		static std::string size(std::uintmax_t bytes);
 
 		/**
 		 * Format as k or M
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace lib
+{
+	/**
+	 * Fast non-cryptographic hashing
+	 */
+	class hash
+	{
+	public:
+		/**
+		 * Initial value for a new hash
+		 */
+		static constexpr std::uint64_t offset_basis = 14695981039346656037ULL;
+
+		/**
+		 * 64-bit FNV-1a hash of data
+		 * @param data Data to hash
+		 * @param size Size of data in bytes
+		 * @param seed Previous hash to continue from
+		 * @return Hash
+		 */
+		static auto fnv1a(const void *data, size_t size,
+			std::uint64_t seed = offset_basis) -> std::uint64_t;
+
+		/**
+		 * 64-bit FNV-1a hash of a string
+		 */
+		static auto fnv1a(const std::string &str,
+			std::uint64_t seed = offset_basis) -> std::uint64_t;
+
+	private:
+		/**
+		 * Static class
+		 */
+		hash() = default;
+
+		static constexpr std::uint64_t prime = 1099511628211ULL;
+	};
+}
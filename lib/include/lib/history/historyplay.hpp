@@ -0,0 +1,34 @@
+#pragma once
+
+#include "lib/spotify/track.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace lib
+{
+	/**
+	 * Single play of a track in listening history
+	 */
+	class history_play
+	{
+	public:
+		history_play() = default;
+
+		history_play(std::int64_t played_at, lib::spt::track track)
+			: played_at(played_at),
+			track(std::move(track))
+		{
+		}
+
+		/**
+		 * Seconds since epoch when track was played
+		 */
+		std::int64_t played_at = 0;
+
+		/**
+		 * Track that was played
+		 */
+		lib::spt::track track;
+	};
+}
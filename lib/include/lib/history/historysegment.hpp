@@ -0,0 +1,132 @@
+#pragma once
+
+#include "lib/enum/playsource.hpp"
+#include "lib/history/historyplay.hpp"
+#include "lib/spotify/track.hpp"
+#include "thirdparty/filesystem.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Listening history for a single month, stored in a binary append-only file
+	 * @note File is a header, followed by track and play records,
+	 * where tracks are only stored once, and plays refer to tracks by index
+	 */
+	class history_segment
+	{
+	public:
+		/**
+		 * Load segment from file, if it exists
+		 * @param path Path to segment file
+		 */
+		explicit history_segment(const ghc::filesystem::path &path);
+
+		/**
+		 * Add play, and append it to file
+		 * @param played_at Seconds since epoch
+		 */
+		void add(const lib::spt::track &track, std::int64_t played_at,
+			lib::play_source source);
+
+		/**
+		 * Track was played between two times, from source
+		 * @param from Seconds since epoch, inclusive
+		 * @param to Seconds since epoch, inclusive
+		 */
+		auto contains(const std::string &track_id, std::int64_t from, std::int64_t to,
+			lib::play_source source) const -> bool;
+
+		/**
+		 * Plays in range, newest first
+		 * @param from Seconds since epoch, inclusive
+		 * @param to Seconds since epoch, exclusive
+		 * @param max_count Maximum number of plays to add
+		 * @param plays Plays to add to
+		 */
+		void newest(std::int64_t from, std::int64_t to, size_t max_count,
+			std::vector<lib::history_play> &plays) const;
+
+		/**
+		 * Number of plays
+		 */
+		auto size() const -> size_t;
+
+	private:
+		/**
+		 * Identifies file as a history segment
+		 */
+		static constexpr std::uint32_t magic = 0x48515053; // "SPQH"
+		static constexpr std::uint32_t version = 1;
+
+		static constexpr std::uint8_t record_track = 'T';
+		static constexpr std::uint8_t record_play = 'P';
+		static constexpr std::uint8_t record_started_play = 'S';
+
+		/**
+		 * Strings and lists are prefixed with a 2 byte size,
+		 * anything longer is cut
+		 */
+		static constexpr size_t max_size = 0xffff;
+
+		/**
+		 * Play, referring to track by index
+		 */
+		class entry
+		{
+		public:
+			std::int64_t played_at;
+			std::uint32_t track;
+			lib::play_source source;
+		};
+
+		ghc::filesystem::path path;
+		std::vector<lib::spt::track> tracks;
+		std::unordered_map<std::string, std::uint32_t> track_indices;
+
+		/**
+		 * All plays, ordered by time
+		 */
+		std::vector<entry> entries;
+
+		void load();
+		void insert(const entry &play);
+
+		/**
+		 * Move invalid file out of the way, so new plays start a new file
+		 */
+		void discard() const;
+
+		static void write_track(std::string &data, const lib::spt::track &track);
+		static void write_play(std::string &data, const entry &play);
+
+		static void write_uint(std::string &data, std::uint64_t value, size_t size);
+		static void write_string(std::string &data, const std::string &value);
+
+		/**
+		 * Reads values from loaded file
+		 * @note Reads past end are ignored, and sets failed
+		 */
+		class reader
+		{
+		public:
+			explicit reader(const std::vector<char> &data);
+
+			auto uint(size_t size) -> std::uint64_t;
+			auto string() -> std::string;
+			auto at_end() const -> bool;
+
+			size_t position = 0;
+			bool failed = false;
+
+		private:
+			const std::vector<char> &data;
+		};
+
+		static auto read_track(reader &reader) -> lib::spt::track;
+	};
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "lib/history/historyplay.hpp"
+#include "lib/history/historysegment.hpp"
+#include "lib/history/listeningstats.hpp"
+#include "lib/spotify/track.hpp"
+#include "thirdparty/filesystem.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Local listening history, not limited to the last 50 plays
+	 * @note Stored as one segment per month, only loaded when needed
+	 */
+	class listening_history
+	{
+	public:
+		/**
+		 * Open history, without loading any plays
+		 * @param dir Directory to store segments in
+		 */
+		explicit listening_history(const ghc::filesystem::path &dir);
+
+		/**
+		 * Saves statistics if changed
+		 */
+		~listening_history();
+
+		/**
+		 * Add play, unless the same play was already added, from either source
+		 * @param played_at Seconds since epoch, see play_source for when
+		 * @note Does not load statistics, they are updated when next loaded
+		 * @return Play was added
+		 */
+		auto add(const lib::spt::track &track, std::int64_t played_at,
+			lib::play_source source = lib::play_source::finished) -> bool;
+
+		/**
+		 * Plays before time, newest first
+		 * @param time Seconds since epoch, exclusive
+		 * @param count Maximum number of plays
+		 */
+		auto before(std::int64_t time, size_t count) const -> std::vector<lib::history_play>;
+
+		/**
+		 * All plays in a month, newest first
+		 * @param key Month, as returned by months()
+		 */
+		auto month(int key) const -> std::vector<lib::history_play>;
+
+		/**
+		 * Months with any plays, newest first
+		 * @return Months as year * 100 + month, for example 202103
+		 */
+		auto months() const -> std::vector<int>;
+
+		/**
+		 * Time of newest play, or 0 if history is empty
+		 */
+		auto newest() const -> std::int64_t;
+
+		/**
+		 * Month a time is in
+		 * @param time Seconds since epoch
+		 * @return Month as year * 100 + month
+		 */
+		static auto month_key(std::int64_t time) -> int;
+
+		/**
+		 * Statistics over all plays
+		 * @note Loaded from file if up to date, otherwise rebuilt from all plays,
+		 * so only call when statistics are shown
+		 */
+		auto stats() const -> const lib::listening_stats &;
+
+		/**
+		 * Save statistics, if changed since loaded
+		 */
+		void save_stats() const;
+
+		/**
+		 * Seconds a track needs to play to count as played,
+		 * or half of the track if shorter
+		 */
+		static constexpr int min_play_seconds = 30;
+
+	private:
+		/**
+		 * Version of saved statistics, rebuilt if different
+		 */
+		static constexpr int stats_version = 1;
+
+		ghc::filesystem::path dir;
+
+		/**
+		 * Loaded segments, or nullptr if not loaded yet
+		 */
+		mutable std::map<int, std::unique_ptr<lib::history_segment>> segments;
+
+		/**
+		 * Loaded statistics, or nullptr if not loaded yet
+		 */
+		mutable std::unique_ptr<lib::listening_stats> stats_data;
+
+		/**
+		 * Size of segment files statistics were saved from,
+		 * to know if statistics are out of date
+		 */
+		mutable std::map<int, std::uintmax_t> stats_sizes;
+		mutable bool stats_changed = false;
+
+		/**
+		 * Plays added before statistics were loaded
+		 */
+		mutable std::vector<lib::history_play> pending_plays;
+
+		/**
+		 * Size of segment files before pending plays were added
+		 */
+		mutable std::map<int, std::uintmax_t> pending_sizes;
+
+		auto segment(int key) const -> lib::history_segment &;
+		auto segment_path(int key) const -> ghc::filesystem::path;
+		auto segment_size(int key) const -> std::uintmax_t;
+
+		auto load_stats() const -> lib::listening_stats &;
+		auto stats_path() const -> ghc::filesystem::path;
+
+		/**
+		 * Parse month from file name, or 0 if invalid
+		 */
+		static auto parse_key(const std::string &file_name) -> int;
+	};
+}
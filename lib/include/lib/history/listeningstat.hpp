@@ -0,0 +1,51 @@
+#pragma once
+
+#include "thirdparty/json.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace lib
+{
+	/**
+	 * Aggregated plays of a track, artist or album
+	 */
+	class listening_stat
+	{
+	public:
+		std::string id;
+		std::string name;
+
+		/**
+		 * Number of times played
+		 */
+		unsigned int plays = 0;
+
+		/**
+		 * Total time played in milliseconds
+		 */
+		long long duration = 0;
+
+		/**
+		 * Seconds since epoch when last played
+		 */
+		std::int64_t last_played = 0;
+
+		/**
+		 * Add a play
+		 * @param duration Length of play in milliseconds
+		 * @param played_at Seconds since epoch
+		 */
+		void add(int duration, std::int64_t played_at);
+	};
+
+	/**
+	 * listening_stat -> json
+	 */
+	void to_json(nlohmann::json &j, const listening_stat &s);
+
+	/**
+	 * json -> listening_stat
+	 */
+	void from_json(const nlohmann::json &j, listening_stat &s);
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "lib/history/listeningstat.hpp"
+#include "lib/stringpool.hpp"
+#include "lib/spotify/track.hpp"
+#include "thirdparty/json.hpp"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Statistics from listening history
+	 * @note Aggregates are updated on every play,
+	 * so getting statistics never needs to go through all plays
+	 */
+	class listening_stats
+	{
+	public:
+		listening_stats() = default;
+
+		/**
+		 * @param utc_offset Offset of local time from UTC in seconds,
+		 * used for hours, week days and days
+		 */
+		explicit listening_stats(std::int64_t utc_offset);
+
+		/**
+		 * Add play to all aggregates
+		 * @param played_at Seconds since epoch
+		 */
+		void add(const lib::spt::track &track, std::int64_t played_at);
+
+		/**
+		 * Most played tracks
+		 * @param count Maximum number of tracks
+		 */
+		auto top_tracks(size_t count) const -> std::vector<lib::listening_stat>;
+
+		/**
+		 * Most played artists
+		 * @param count Maximum number of artists
+		 */
+		auto top_artists(size_t count) const -> std::vector<lib::listening_stat>;
+
+		/**
+		 * Most played albums
+		 * @param count Maximum number of albums
+		 */
+		auto top_albums(size_t count) const -> std::vector<lib::listening_stat>;
+
+		/**
+		 * Plays per hour of the day, in local time
+		 */
+		auto hours() const -> const std::array<unsigned int, 24> &;
+
+		/**
+		 * Plays per day of the week, in local time, starting on Monday
+		 */
+		auto week_days() const -> const std::array<unsigned int, 7> &;
+
+		/**
+		 * Plays per day, in local time
+		 * @return Days since epoch, and plays that day
+		 */
+		auto days() const -> const std::map<std::int64_t, unsigned int> &;
+
+		/**
+		 * Total number of plays
+		 */
+		auto plays() const -> size_t;
+
+		/**
+		 * Total time played in milliseconds
+		 */
+		auto duration() const -> long long;
+
+		/**
+		 * Offset used for local time, in seconds
+		 */
+		auto get_utc_offset() const -> std::int64_t;
+
+		/**
+		 * Current offset of local time from UTC, rounded to 15 minutes
+		 */
+		static auto local_utc_offset() -> std::int64_t;
+
+	private:
+		using stat_map = std::unordered_map<lib::interned_string, lib::listening_stat>;
+
+		std::int64_t utc_offset = 0;
+
+		/**
+		 * Keys, so maps don't need their own copy of every id
+		 */
+		lib::string_pool ids;
+
+		stat_map tracks;
+		stat_map artists;
+		stat_map albums;
+
+		std::array<unsigned int, 24> hour_plays{};
+		std::array<unsigned int, 7> week_day_plays{};
+		std::map<std::int64_t, unsigned int> day_plays;
+
+		size_t play_count = 0;
+		long long total_duration = 0;
+
+		void add(stat_map &stats,
+			const std::string &id, const std::string &name,
+			int duration, std::int64_t played_at);
+
+		static auto top(const stat_map &stats, size_t count) -> std::vector<lib::listening_stat>;
+
+		friend void to_json(nlohmann::json &j, const listening_stats &s);
+		friend void from_json(const nlohmann::json &j, listening_stats &s);
+	};
+
+	/**
+	 * listening_stats -> json
+	 */
+	void to_json(nlohmann::json &j, const listening_stats &s);
+
+	/**
+	 * json -> listening_stats
+	 */
+	void from_json(const nlohmann::json &j, listening_stats &s);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace lib
+{
+	class string_pool;
+
+	/**
+	 * Handle to an immutable string in a string_pool
+	 * @note Only valid as long as the pool it came from
+	 */
+	class interned_string
+	{
+	public:
+		/**
+		 * Empty string, not from any pool
+		 */
+		interned_string();
+
+		/**
+		 * String value
+		 */
+		auto str() const -> const std::string &;
+
+		/**
+		 * Use as a regular string
+		 */
+		operator const std::string &() const;
+
+		auto empty() const -> bool;
+
+		/**
+		 * Compare strings from the same pool, without comparing characters
+		 */
+		auto operator==(const interned_string &other) const -> bool;
+		auto operator!=(const interned_string &other) const -> bool;
+
+		/**
+		 * Compare characters, for sorting
+		 */
+		auto operator<(const interned_string &other) const -> bool;
+
+	private:
+		explicit interned_string(const std::string *value);
+
+		const std::string *value;
+
+		friend class string_pool;
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<lib::interned_string>
+	{
+		auto operator()(const lib::interned_string &str) const -> size_t
+		{
+			// Equal strings are the same string in the pool
+			return hash<const void *>()(&str.str());
+		}
+	};
+}
@@ -5,6 +5,7 @@
 #include "thirdparty/filesystem.hpp"
 
 #include <fstream>
+#include <vector>
 
 namespace lib
 {
@@ -49,9 +50,10 @@ namespace lib
 		 * @param json JSON to find item in
 		 * @param key Key to try and find
 		 * @param item Item to set value to
+		 * @note Also works with other JSON types, like arena_json
 		 */
-		template<typename T>
-		static void get(const nlohmann::json &json, const std::string &key, T &item)
+		template<typename Json, typename T>
+		static void get(const Json &json, const std::string &key, T &item)
 		{
 			if (json.contains(key) && !json.at(key).is_null())
 				json.at(key).get_to(item);
@@ -64,6 +66,46 @@ namespace lib
 		 */
 		static nlohmann::json load(const ghc::filesystem::path &path);
 
+		/**
+		 * Read entire file at once
+		 * @param path Path to file
+		 * @param data Buffer to read into, resized to file size
+		 * @return If file could be read
+		 */
+		template<typename T>
+		static auto read_file(const ghc::filesystem::path &path, std::vector<T> &data) -> bool
+		{
+			static_assert(sizeof(T) == 1, "Buffer must be bytes");
+
+			std::ifstream file(path, std::ios::binary);
+			if (!file.is_open() || file.bad())
+			{
+				return false;
+			}
+
+			file.seekg(0, std::ios::end);
+			const auto size = file.tellg();
+			if (size < 0)
+			{
+				return false;
+			}
+			file.seekg(0, std::ios::beg);
+
+			data.resize(static_cast<size_t>(size));
+			file.read(reinterpret_cast<char *>(data.data()),
+				static_cast<std::streamsize>(data.size()));
+			data.resize(static_cast<size_t>(file.gcount()));
+			return true;
+		}
+
+		/**
+		 * Read entire file at once, and parse JSON from it
+		 * @param path Path to json file, including extension
+		 * @return JSON object, or null object if file wasn't found
+		 * @throws nlohmann::json::exception JSON is invalid
+		 */
+		static auto parse_file(const ghc::filesystem::path &path) -> nlohmann::json;
+
 		/**
 		 * Convenience method to parse generic class from JSON,
 		 * returns instance of T on failure
@@ -88,5 +130,10 @@ namespace lib
 
 	private:
 		json() = default;
+
+		/**
+		 * Largest read buffer kept between loads, in bytes
+		 */
+		static constexpr size_t max_buffer_size = 8 * 1024 * 1024;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Fewest changes to turn one list into another
+	 * @note Items are compared by key, which is unique within each list,
+	 * and used as index, so should be small, like an index in a list
+	 */
+	class list_diff
+	{
+	public:
+		enum class change_type
+		{
+			remove,
+			insert,
+			move,
+		};
+
+		/**
+		 * Change to list, only valid after all previous changes were applied
+		 */
+		struct change
+		{
+			change_type type;
+
+			/**
+			 * Index of item to remove or move, or index in next list of item to insert
+			 */
+			size_t from;
+
+			/**
+			 * Index to insert or move item before, or unused when removing
+			 * @note Index is in list before change, so can be size to add last
+			 */
+			size_t to;
+		};
+
+		/**
+		 * @param previous Key for each item before
+		 * @param next Key for each item after
+		 * @param max_changes If more changes are needed, none are created
+		 */
+		list_diff(const std::vector<size_t> &previous, const std::vector<size_t> &next,
+			size_t max_changes = std::numeric_limits<size_t>::max());
+
+		/**
+		 * Changes to apply, in order
+		 */
+		auto changes() const -> const std::vector<change> &;
+
+		/**
+		 * Lists are equal
+		 */
+		auto empty() const -> bool;
+
+		/**
+		 * More than max changes are needed, and none were created
+		 */
+		auto exceeds_limit() const -> bool;
+
+	private:
+		std::vector<change> items;
+		bool exceeded = false;
+
+		/**
+		 * Longest increasing sequence of values
+		 * @return If value is part of sequence, for each value
+		 */
+		static auto longest_increasing(const std::vector<size_t> &values) -> std::vector<bool>;
+	};
+}
@@ -6,6 +6,7 @@
 #include "lib/developermode.hpp"
 
 #include <iostream>
+#include <mutex>
 #include <regex>
 
 namespace lib
@@ -126,6 +127,8 @@ namespace lib
 		 */
 		static bool log_to_stdout;
 
+		static std::mutex mutex;
+
 		/**
 		 * Log a message with the specified type
 		 * @param logType Type of log
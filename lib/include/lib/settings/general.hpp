@@ -108,6 +108,11 @@ namespace lib
 			 */
 			bool tray_notifications = false;
 
+			/**
+			 * When all liked tracks were last fetched, in seconds since epoch
+			 */
+			long last_saved_tracks_sync = 0;
+
 			/**
 			 * Volume last set
 			 * @note Should be 0-20, representing 0-100% as steps of 5
@@ -119,6 +124,12 @@ namespace lib
 			 */
 			int refresh_interval = 3;
 
+			/**
+			 * Maximum size of cached album images in megabytes,
+			 * least recently used images are removed on start
+			 */
+			int album_cache_size = 100;
+
 			/**
 			 * How to resize track list headers
 			 */
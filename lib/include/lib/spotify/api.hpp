@@ -7,12 +7,16 @@
 #include "lib/spotify/playback.hpp"
 #include "lib/enum/repeatstate.hpp"
 #include "lib/json.hpp"
+#include "lib/arena.hpp"
 #include "lib/enum/followtype.hpp"
 #include "lib/spotify/error.hpp"
+#include "lib/spotify/id.hpp"
 #include "lib/spotify/album.hpp"
 #include "lib/spotify/artist.hpp"
 #include "lib/spotify/playlist.hpp"
 #include "lib/spotify/playlistdetails.hpp"
+#include "lib/spotify/playlistdelta.hpp"
+#include "lib/spotify/savedtracksdelta.hpp"
 #include "lib/spotify/searchresults.hpp"
 #include "lib/spotify/track.hpp"
 #include "lib/spotify/audiofeatures.hpp"
@@ -23,6 +27,8 @@
 
 #include "thirdparty/json.hpp"
 
+#include <memory>
+
 namespace lib
 {
 	namespace spt
@@ -46,7 +52,7 @@ namespace lib
 				lib::callback<lib::spt::album> &callback);
 
 			void album_tracks(const lib::spt::album &album,
-				lib::callback<std::vector<lib::spt::track>> &callback);
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
 
 			//endregion
 
@@ -91,7 +97,15 @@ namespace lib
 
 			void saved_albums(lib::callback<std::vector<lib::spt::saved_album>> &callback);
 
-			void saved_tracks(lib::callback<std::vector<lib::spt::track>> &callback);
+			void saved_tracks(lib::move_callback<std::vector<lib::spt::track>> &callback);
+
+			/**
+			 * Get saved tracks, only fetching tracks saved since cached
+			 * @param cached Cached saved tracks, newest first
+			 * @param callback All saved tracks
+			 */
+			void saved_tracks(const std::vector<lib::spt::track> &cached,
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
 
 			void add_saved_track(const std::string &track_id,
 				lib::callback<std::string> &callback);
@@ -217,6 +231,14 @@ namespace lib
 			 */
 			void recently_played(lib::callback<std::vector<lib::spt::track>> &callback);
 
+			/**
+			 * Get recently played tracks, played after a specific time
+			 * @param after Milliseconds since epoch
+			 * @note Tracks have added_at set to when they were played
+			 */
+			void recently_played(long long after,
+				lib::callback<std::vector<lib::spt::track>> &callback);
+
 			/**
 			 * Add specified track to play next
 			 * @param uri URI of track to add
@@ -237,7 +259,24 @@ namespace lib
 				lib::callback<std::string> &callback);
 
 			void playlist_tracks(const lib::spt::playlist &playlist,
-				lib::callback<std::vector<lib::spt::track>> &callback);
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
+
+			/**
+			 * Get tracks in playlist, starting from a specific index
+			 * @param offset Index of first track
+			 */
+			void playlist_tracks(const lib::spt::playlist &playlist, int offset,
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
+
+			/**
+			 * Get tracks in playlist, only fetching what changed since it was cached
+			 * @param cached Cached playlist, with tracks and snapshot
+			 * @param latest Latest playlist, with snapshot and total tracks
+			 * @param callback All tracks in latest playlist
+			 */
+			void playlist_tracks(const lib::spt::playlist &cached,
+				const lib::spt::playlist &latest,
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
 
 			void add_to_playlist(const std::string &playlist_id, const std::string &track_id,
 				lib::callback<std::string> &callback);
@@ -286,6 +325,14 @@ namespace lib
 			 */
 			static auto to_uri(const std::string &type, const std::string &id) -> std::string;
 
+			/**
+			 * Packed Spotify ID to Spotify URI
+			 * @param type URI type, for example artist, album, track, etc.
+			 * @param id Spotify ID
+			 * @return Spotify URI, or an empty string if ID is invalid
+			 */
+			static auto to_uri(const std::string &type, const lib::spt::id &id) -> std::string;
+
 			/**
 			 * Spotify URI (spotify:track:4uLU6hMCjMI75M1A2tKUQC) to Spotify ID
 			 * (4uLU6hMCjMI75M1A2tKUQC)
@@ -295,6 +342,13 @@ namespace lib
 			 */
 			static auto to_id(const std::string &id) -> std::string;
 
+			/**
+			 * Spotify URI or ID to packed Spotify ID
+			 * @param id Spotify URI or ID
+			 * @return Packed ID, invalid if not a Spotify ID, for example local tracks
+			 */
+			static auto to_packed_id(const std::string &id) -> lib::spt::id;
+
 		protected:
 			/**
 			 * Allow use to select device, by default, none is chosen
@@ -333,13 +387,22 @@ namespace lib
 			 * @throws std::exception
 			 */
 			void get_items(const std::string &url,
-				lib::callback<nlohmann::json> &callback);
+				lib::move_callback<nlohmann::json> &callback);
 
 			/**
 			 * Custom get_items when items are contained in a key
 			 */
 			void get_items(const std::string &url, const std::string &key,
-				lib::callback<nlohmann::json> &callback);
+				lib::move_callback<nlohmann::json> &callback);
+
+			/**
+			 * GET a collection of tracks
+			 * @param url URL to request
+			 * @note Automatically handles paging
+			 * @note Each page is parsed in an arena, and thrown away once converted
+			 */
+			void get_track_items(const std::string &url,
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
 
 			//endregion
 
@@ -438,6 +501,46 @@ namespace lib
 			 */
 			static auto to_full_url(const std::string &relative_url) -> std::string;
 
+			/**
+			 * Get relative API url from full URL, or URL as-is if already relative
+			 */
+			static auto to_relative_url(const std::string &url) -> std::string;
+
+			/**
+			 * Fetch a page of saved tracks, and the next one, until delta is complete
+			 */
+			void saved_tracks_page(const std::string &url,
+				const std::shared_ptr<const std::vector<lib::spt::track>> &cached,
+				const std::shared_ptr<lib::spt::saved_tracks_delta> &delta,
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
+
+			/**
+			 * Fetch tracks to check in playlist, one check at a time
+			 * @param checks Index of first track, and number of tracks, for each check
+			 * @param index Index of check to fetch next
+			 * @param checked Tracks from all previous checks
+			 */
+			void playlist_checks(const lib::spt::playlist &playlist,
+				const std::shared_ptr<const std::vector<std::pair<int, int>>> &checks,
+				size_t index, const std::shared_ptr<std::vector<lib::spt::track>> &checked,
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
+
+			/**
+			 * Fetch a page of items, and the next one, until there are no more pages
+			 * @param items Items from all previous pages
+			 */
+			void get_items_page(const std::string &url, const std::string &key,
+				const std::shared_ptr<nlohmann::json> &items,
+				lib::move_callback<nlohmann::json> &callback);
+
+			/**
+			 * Fetch a page of tracks, and the next one, until there are no more pages
+			 * @param tracks Tracks from all previous pages
+			 */
+			void get_track_items_page(const std::string &url,
+				const std::shared_ptr<std::vector<lib::spt::track>> &tracks,
+				lib::move_callback<std::vector<lib::spt::track>> &callback);
+
 			/**
 			 * Set last used device
 			 * @param id Device ID
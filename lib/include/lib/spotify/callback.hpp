@@ -10,6 +10,13 @@ namespace lib
 	template<typename T>
 	using callback = const std::function<void(const T &)>;
 
+	/**
+	 * API callback that takes ownership of the result
+	 * @note Callbacks taking a const reference can still be used
+	 */
+	template<typename T>
+	using move_callback = const std::function<void(T &&)>;
+
 	/**
 	 * Callback with bool indicating success
 	 */
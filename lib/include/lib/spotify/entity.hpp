@@ -1,6 +1,7 @@
 #pragma once
 
 #include "lib/strings.hpp"
+#include "lib/arenajson.hpp"
 
 #include "thirdparty/json.hpp"
 
@@ -51,5 +52,10 @@ namespace lib
 		 * json -> entity
 		 */
 		void from_json(const nlohmann::json &j, entity &e);
+
+		/**
+		 * arena json -> entity
+		 */
+		void from_json(const lib::arena_json &j, entity &e);
 	}
 }
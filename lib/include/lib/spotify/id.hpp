@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Spotify ID (4uLU6hMCjMI75M1A2tKUQC), packed into 16 bytes
+		 * @note IDs are 128-bit numbers, encoded as 22 base62 characters
+		 */
+		class id
+		{
+		public:
+			/**
+			 * Invalid ID
+			 */
+			id() = default;
+
+			/**
+			 * Parse ID
+			 * @param value Spotify ID, not URI
+			 * @note Invalid if not a Spotify ID, for example local tracks
+			 */
+			explicit id(const std::string &value);
+
+			/**
+			 * Value is a Spotify ID
+			 */
+			auto is_valid() const -> bool;
+
+			/**
+			 * Base62 encoded ID, or an empty string if invalid
+			 */
+			auto to_string() const -> std::string;
+
+			auto operator==(const id &other) const -> bool;
+			auto operator!=(const id &other) const -> bool;
+			auto operator<(const id &other) const -> bool;
+
+			/**
+			 * Hash for unordered containers
+			 */
+			auto hash() const -> size_t;
+
+			/**
+			 * Number of characters in an encoded ID
+			 */
+			static constexpr size_t length = 22;
+
+		private:
+			/**
+			 * All bits set is used as invalid, which is never used by Spotify
+			 */
+			std::uint64_t high = ~0ULL;
+			std::uint64_t low = ~0ULL;
+
+			static auto digit(char c) -> int;
+		};
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<lib::spt::id>
+	{
+		auto operator()(const lib::spt::id &id) const -> size_t
+		{
+			return id.hash();
+		}
+	};
+}
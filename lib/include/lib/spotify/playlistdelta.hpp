@@ -0,0 +1,83 @@
+#pragma once
+
+#include "lib/spotify/playlist.hpp"
+#include "lib/spotify/track.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Changes between a cached playlist and its latest version
+		 * @note Only appended tracks can be detected, any other change
+		 * requires all tracks to be fetched again
+		 * @note Snapshots don't say what changed, so tracks before the end are
+		 * checked as well, as tracks can be replaced without moving the last one
+		 */
+		class playlist_delta
+		{
+		public:
+			/**
+			 * Compare cached playlist with latest version
+			 * @param cached Cached playlist, with tracks and snapshot
+			 * @param latest Latest playlist, with snapshot and total tracks
+			 */
+			playlist_delta(const lib::spt::playlist &cached,
+				const lib::spt::playlist &latest);
+
+			/**
+			 * Cached tracks are up to date, nothing needs to be fetched
+			 */
+			auto is_up_to_date() const -> bool;
+
+			/**
+			 * Tracks were probably only appended,
+			 * and only tracks from offset() needs to be fetched
+			 */
+			auto is_append() const -> bool;
+
+			/**
+			 * Index of first track to fetch
+			 * @note Includes last cached track, to verify nothing else changed
+			 */
+			auto offset() const -> int;
+
+			/**
+			 * Cached tracks to fetch again, to check they didn't change
+			 * @note First page, and a few tracks spread over the rest
+			 * @return Index of first track, and number of tracks
+			 */
+			auto checks() const -> std::vector<std::pair<int, int>>;
+
+			/**
+			 * Apply fetched tracks to cached tracks
+			 * @param checked Tracks fetched for checks(), in order
+			 * @param fetched Tracks fetched from offset()
+			 * @param tracks Cached tracks to append to
+			 * @return Delta could be applied, otherwise all tracks need to be fetched
+			 */
+			auto apply(const std::vector<lib::spt::track> &checked,
+				const std::vector<lib::spt::track> &fetched,
+				std::vector<lib::spt::track> &tracks) const -> bool;
+
+		private:
+			/**
+			 * Tracks checked from the start, one page
+			 */
+			static constexpr int page_size = 100;
+
+			/**
+			 * Tracks checked after the first page
+			 */
+			static constexpr int sample_count = 4;
+
+			int cached_total = 0;
+			int latest_total = -1;
+			bool up_to_date = false;
+			std::string last_id;
+		};
+	}
+}
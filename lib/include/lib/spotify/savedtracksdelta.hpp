@@ -0,0 +1,77 @@
+#pragma once
+
+#include "lib/spotify/id.hpp"
+#include "lib/spotify/track.hpp"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Tracks saved since liked tracks were cached
+		 * @note Saved tracks are ordered newest first, so only pages
+		 * until the newest cached track need to be fetched
+		 */
+		class saved_tracks_delta
+		{
+		public:
+			/**
+			 * @param cached Cached saved tracks, with when they were added
+			 */
+			explicit saved_tracks_delta(const std::vector<lib::spt::track> &cached);
+
+			/**
+			 * Add next page of fetched tracks
+			 * @return More pages needs to be fetched
+			 */
+			auto add(const std::vector<lib::spt::track> &page) -> bool;
+
+			/**
+			 * Merge added tracks with cached tracks
+			 * @param total Total number of saved tracks, as reported by the API
+			 * @param tracks Cached tracks to merge into
+			 * @return Delta could be applied, otherwise all tracks need to be fetched
+			 */
+			auto apply(int total, std::vector<lib::spt::track> &tracks) const -> bool;
+
+			/**
+			 * Tracks added since cache, newest first
+			 */
+			auto added() const -> const std::vector<lib::spt::track> &;
+
+		private:
+			/**
+			 * Track IDs, packed if Spotify IDs, otherwise as strings,
+			 * as local tracks don't have one
+			 */
+			class id_set
+			{
+			public:
+				void insert(const std::string &id);
+				auto contains(const std::string &id) const -> bool;
+				void clear();
+
+			private:
+				std::unordered_set<lib::spt::id> ids;
+				std::unordered_set<std::string> other_ids;
+			};
+
+			/**
+			 * When the newest cached track was added
+			 */
+			std::string watermark;
+
+			/**
+			 * Cached tracks added at the same time as the watermark
+			 */
+			id_set watermark_ids;
+
+			std::vector<lib::spt::track> new_tracks;
+			bool done = false;
+		};
+	}
+}
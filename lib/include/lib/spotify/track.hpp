@@ -81,5 +81,10 @@ namespace lib
 		 * json -> track
 		 */
 		void from_json(const nlohmann::json &j, track &t);
+
+		/**
+		 * arena json -> track
+		 */
+		void from_json(const lib::arena_json &j, track &t);
 	}
 }
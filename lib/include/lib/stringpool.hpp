@@ -0,0 +1,53 @@
+#pragma once
+
+#include "lib/internedstring.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace lib
+{
+	/**
+	 * Stores each unique string once, and hands out handles to it
+	 * @note Safe to use from multiple threads
+	 */
+	class string_pool
+	{
+	public:
+		string_pool() = default;
+
+		string_pool(const string_pool &) = delete;
+		auto operator=(const string_pool &) -> string_pool & = delete;
+
+		/**
+		 * Move all strings, handles stay valid
+		 */
+		string_pool(string_pool &&other) noexcept;
+		auto operator=(string_pool &&other) noexcept -> string_pool &;
+
+		/**
+		 * Get handle to string, adding it if not already in pool
+		 */
+		auto intern(const std::string &value) -> lib::interned_string;
+
+		/**
+		 * Number of unique strings
+		 */
+		auto size() const -> size_t;
+
+		/**
+		 * Number of characters in all unique strings
+		 */
+		auto bytes() const -> size_t;
+
+	private:
+		mutable std::mutex mutex;
+
+		/**
+		 * Nodes are never moved, so handles stay valid when rehashing
+		 */
+		std::unordered_set<std::string> strings;
+		size_t string_bytes = 0;
+	};
+}
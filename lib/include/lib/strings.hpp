@@ -120,6 +120,15 @@ namespace lib
 		 */
 		static auto to_lower(const std::string &str) -> std::string;
 
+		/**
+		 * Get UTF-8 string with case folded, for case insensitive comparisons
+		 * @param str String to transform
+		 * @return Folded string
+		 * @note Only simple folding of Latin, Greek, Cyrillic and Armenian letters,
+		 * invalid UTF-8 is kept as is
+		 */
+		static auto fold_case(const std::string &str) -> std::string;
+
 		/**
 		 * Get string as all uppercase
 		 * @param str String to transform
@@ -187,5 +196,17 @@ namespace lib
 		 * @param str String to trim
 		 */
 		static void trim_end(std::string &str);
+
+		/**
+		 * Fold case of a single code point
+		 * @param code Unicode code point
+		 * @return Folded code point, or code if not changed
+		 */
+		static auto fold_code_point(char32_t code) -> char32_t;
+
+		/**
+		 * Append code point to string as UTF-8
+		 */
+		static void append_utf8(std::string &str, char32_t code);
 	};
 }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "lib/enum/trackcolumn.hpp"
+#include "lib/spotify/track.hpp"
+#include "lib/stringpool.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Tracks stored as one array per column, for sorting, filtering
+	 * and summing large lists without going through full track objects
+	 * @note Strings are interned, so each unique name is only stored once
+	 */
+	class track_columns
+	{
+	public:
+		track_columns() = default;
+
+		explicit track_columns(const std::vector<lib::spt::track> &tracks);
+
+		/**
+		 * Add track as last row
+		 */
+		void push_back(const lib::spt::track &track);
+
+		/**
+		 * Number of rows
+		 */
+		auto size() const -> size_t;
+
+		auto empty() const -> bool;
+
+		//region Columns
+
+		auto name(size_t row) const -> const std::string &;
+
+		/**
+		 * Names of all artists, comma separated
+		 */
+		auto artist(size_t row) const -> const std::string &;
+
+		auto album(size_t row) const -> const std::string &;
+
+		/**
+		 * Duration in milliseconds
+		 */
+		auto duration(size_t row) const -> int;
+
+		/**
+		 * When added, in seconds since epoch, or 0 if unknown
+		 */
+		auto added_at(size_t row) const -> std::int64_t;
+
+		auto is_local(size_t row) const -> bool;
+		auto is_playable(size_t row) const -> bool;
+
+		//endregion
+
+		/**
+		 * Rows sorted by column, equal rows keep their order
+		 * @note Text is sorted ignoring case and a leading "The "
+		 * @note Creates sort key every time, use track_sort_keys to sort more than once
+		 * @return Row indices, in sorted order
+		 */
+		auto sort(lib::track_column column, bool ascending) const -> std::vector<size_t>;
+
+		/**
+		 * Duration of all rows in milliseconds
+		 */
+		auto total_duration() const -> long long;
+
+		/**
+		 * Number of rows that can be played
+		 */
+		auto playable_count() const -> size_t;
+
+	private:
+		static constexpr std::uint8_t flag_local = 1U;
+		static constexpr std::uint8_t flag_playable = 2U;
+
+		lib::string_pool strings;
+
+		std::vector<lib::interned_string> names;
+		std::vector<lib::interned_string> artists;
+		std::vector<lib::interned_string> albums;
+		std::vector<int> durations;
+		std::vector<std::int64_t> added;
+		std::vector<std::uint8_t> flags;
+	};
+}
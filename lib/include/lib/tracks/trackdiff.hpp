@@ -0,0 +1,63 @@
+#pragma once
+
+#include "lib/spotify/track.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Which tracks are the same in a refreshed track list
+	 * @note Tracks are matched by ID, and by position for tracks added more than once
+	 */
+	class track_diff
+	{
+	public:
+		/**
+		 * Track is not in other list
+		 */
+		static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+		track_diff(const std::vector<lib::spt::track> &previous,
+			const std::vector<lib::spt::track> &next);
+
+		/**
+		 * Index in next for each track in previous, or npos if removed
+		 */
+		auto next_indices() const -> const std::vector<size_t> &;
+
+		/**
+		 * Keys of previous tracks, to compare with indices in next in list_diff
+		 * @param rows Index in previous, for each row
+		 * @return Index in next, or a key not in next if removed
+		 */
+		auto keys(const std::vector<size_t> &rows) const -> std::vector<size_t>;
+
+		/**
+		 * All tracks are the same, and in the same order
+		 */
+		auto empty() const -> bool;
+
+		/**
+		 * Any matched track has different details, like name or date added
+		 */
+		auto has_changed_tracks() const -> bool;
+
+	private:
+		std::vector<size_t> indices;
+		size_t next_size = 0;
+		bool changed_tracks = false;
+
+		/**
+		 * Key to match track on, ID if it has one, otherwise name
+		 */
+		static auto key(const lib::spt::track &track) -> const std::string &;
+
+		/**
+		 * Track has same details
+		 */
+		static auto is_same(const lib::spt::track &track1,
+			const lib::spt::track &track2) -> bool;
+	};
+}
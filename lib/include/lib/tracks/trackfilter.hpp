@@ -0,0 +1,63 @@
+#pragma once
+
+#include "lib/tracks/trackcolumns.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Filter rows by text while typing
+	 * @note Lowercase text is created once, when constructed,
+	 * and previous results are reused when the query only grows
+	 */
+	class track_filter
+	{
+	public:
+		track_filter() = default;
+
+		explicit track_filter(const lib::track_columns &columns);
+
+		/**
+		 * Number of rows
+		 */
+		auto size() const -> size_t;
+
+		/**
+		 * Rows where title, artist or album contains query, ignoring case
+		 * @return Row indices, in original order, valid until next call
+		 */
+		auto filter(const std::string &query) -> const std::vector<size_t> &;
+
+	private:
+		/**
+		 * Each unique text, with case folded
+		 */
+		std::vector<std::string> texts;
+
+		/**
+		 * Index in texts for each row
+		 */
+		std::vector<std::uint32_t> titles;
+		std::vector<std::uint32_t> artists;
+		std::vector<std::uint32_t> albums;
+
+		struct result
+		{
+			std::string query;
+			std::vector<size_t> rows;
+		};
+
+		/**
+		 * Previous results, where each query contains the one before it
+		 */
+		std::vector<result> results;
+
+		/**
+		 * All rows, for an empty query
+		 */
+		std::vector<size_t> all_rows;
+	};
+}
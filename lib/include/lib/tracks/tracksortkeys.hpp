@@ -0,0 +1,83 @@
+#pragma once
+
+#include "lib/enum/trackcolumn.hpp"
+#include "lib/tracks/trackcolumns.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Integer key for each row and column, so sorting never compares text
+	 * @note Never modified once created, so can be sorted from any thread
+	 */
+	class track_sort_keys
+	{
+	public:
+		track_sort_keys() = default;
+
+		/**
+		 * Keys for all columns
+		 */
+		explicit track_sort_keys(const lib::track_columns &columns);
+
+		/**
+		 * Keys for only one column, when only sorting once
+		 */
+		track_sort_keys(const lib::track_columns &columns, lib::track_column column);
+
+		/**
+		 * Number of rows
+		 */
+		auto size() const -> size_t;
+
+		/**
+		 * Rows sorted by column, equal rows keep their order
+		 * @note Text is sorted ignoring case and a leading "The "
+		 * @return Row indices, in sorted order
+		 * @throws std::invalid_argument Keys were not created for column
+		 */
+		auto sort(lib::track_column column, bool ascending) const -> std::vector<size_t>;
+
+	private:
+		size_t rows = 0;
+
+		/**
+		 * Rank of text in each row, where equal text gets equal rank
+		 */
+		std::vector<std::uint32_t> titles;
+		std::vector<std::uint32_t> artists;
+		std::vector<std::uint32_t> albums;
+
+		std::vector<int> durations;
+		std::vector<std::int64_t> added;
+
+		/**
+		 * Create keys for column, if not already created
+		 */
+		void add(const lib::track_columns &columns, lib::track_column column);
+
+		/**
+		 * Row indices sorted by key
+		 */
+		template<typename T>
+		auto sort_by(const std::vector<T> &keys, bool ascending) const -> std::vector<size_t>;
+
+		using text_column = const std::string &(lib::track_columns::*)(size_t) const;
+
+		/**
+		 * Rank of each row, where equal text gets equal rank,
+		 * so text only needs to be compared once per unique string
+		 * @note Text is interned, so equal text is at the same address
+		 */
+		static auto text_ranks(const lib::track_columns &columns, text_column text)
+			-> std::vector<std::uint32_t>;
+
+		/**
+		 * Text to compare when sorting
+		 */
+		static auto sort_text(const std::string &text) -> std::string;
+	};
+}
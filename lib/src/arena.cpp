@@ -0,0 +1,87 @@
+#include "lib/arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+constexpr size_t lib::arena::default_block_size;
+constexpr size_t lib::arena::max_block_size;
+
+static thread_local lib::arena *current_arena = nullptr;
+
+lib::arena::arena(size_t block_size)
+	: next_block_size(std::max<size_t>(block_size, 1))
+{
+}
+
+auto lib::arena::allocate(size_t size, size_t alignment) -> void *
+{
+	auto *ptr = allocate_in_block(size, alignment);
+	if (ptr != nullptr)
+	{
+		return ptr;
+	}
+
+	// Room for padding, in case alignment is stricter than what new[] guarantees
+	add_block(size + alignment);
+	return allocate_in_block(size, alignment);
+}
+
+auto lib::arena::allocate_in_block(size_t size, size_t alignment) -> void *
+{
+	if (blocks.empty())
+	{
+		return nullptr;
+	}
+
+	auto *block = blocks.back().get();
+	const auto address = reinterpret_cast<std::uintptr_t>(block) + block_used;
+	const auto padding = (alignment - address % alignment) % alignment;
+
+	if (block_used + padding + size > block_size)
+	{
+		return nullptr;
+	}
+
+	auto *ptr = block + block_used + padding;
+	block_used += padding + size;
+	return ptr;
+}
+
+void lib::arena::add_block(size_t size)
+{
+	previous_capacity += block_size;
+	previous_used += block_used;
+
+	block_size = std::max(size, next_block_size);
+	block_used = 0;
+	blocks.emplace_back(new char[block_size]);
+
+	next_block_size = std::min(next_block_size * 2,
+		std::max(max_block_size, next_block_size));
+}
+
+auto lib::arena::capacity() const -> size_t
+{
+	return previous_capacity + block_size;
+}
+
+auto lib::arena::used() const -> size_t
+{
+	return previous_used + block_used;
+}
+
+auto lib::arena::current() -> arena *
+{
+	return current_arena;
+}
+
+lib::arena::scope::scope(arena &arena)
+	: previous(current_arena)
+{
+	current_arena = &arena;
+}
+
+lib::arena::scope::~scope()
+{
+	current_arena = previous;
+}
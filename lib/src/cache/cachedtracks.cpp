@@ -0,0 +1,19 @@
+#include "lib/cache/cachedtracks.hpp"
+
+auto lib::cached_tracks::load(const lib::cache &cache) -> lib::track_columns
+{
+	lib::track_columns columns;
+
+	cache.all_tracks([&columns](const std::string &/*id*/,
+		const std::vector<lib::spt::track> &tracks) -> bool
+	{
+		// Only the columns are kept, the loaded list is freed after each call
+		for (const auto &track : tracks)
+		{
+			columns.push_back(track);
+		}
+		return true;
+	});
+
+	return columns;
+}
@@ -0,0 +1,27 @@
+#include "lib/cache/cacheentry.hpp"
+#include "lib/json.hpp"
+
+void lib::to_json(nlohmann::json &j, const cache_entry &e)
+{
+	j = nlohmann::json{
+		{"size", e.size},
+		{"last_access", e.last_access},
+		{"hash", e.hash},
+		{"content_hash", e.content_hash},
+		{"version", e.version},
+	};
+}
+
+void lib::from_json(const nlohmann::json &j, cache_entry &e)
+{
+	if (!j.is_object())
+	{
+		return;
+	}
+
+	j.at("size").get_to(e.size);
+	j.at("last_access").get_to(e.last_access);
+	j.at("hash").get_to(e.hash);
+	j.at("version").get_to(e.version);
+	lib::json::get(j, "content_hash", e.content_hash);
+}
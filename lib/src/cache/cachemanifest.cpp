@@ -0,0 +1,431 @@
+#include "lib/cache/cachemanifest.hpp"
+#include "lib/datetime.hpp"
+#include "lib/log.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+constexpr int lib::cache_manifest::manifest_version;
+constexpr int lib::cache_manifest::max_journal_size;
+
+lib::cache_manifest::cache_manifest(const ghc::filesystem::path &dir,
+	const std::vector<std::string> &types, bool read_only)
+	: dir(dir),
+	types(types),
+	read_only(read_only)
+{
+	if (!load())
+	{
+		rebuild();
+	}
+}
+
+lib::cache_manifest::~cache_manifest()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (changed)
+	{
+		write();
+	}
+}
+
+void lib::cache_manifest::update(const std::string &type, const std::string &name,
+	size_t size, std::uint64_t hash, int version, std::uint64_t content_hash)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	cache_entry entry;
+	entry.size = size;
+	entry.last_access = lib::date_time::seconds_since_epoch();
+	entry.hash = hash;
+	entry.version = version;
+	entry.content_hash = content_hash;
+
+	set(type, name, entry);
+	journal({
+		{"type", type},
+		{"name", name},
+		{"entry", entry},
+	});
+}
+
+void lib::cache_manifest::remove(const std::string &type, const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	unset(type, name);
+	journal({
+		{"type", type},
+		{"name", name},
+	});
+}
+
+void lib::cache_manifest::touch(const std::string &type, const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto entry = entries.find(type);
+	if (entry == entries.end())
+	{
+		return;
+	}
+
+	auto file = entry->second.find(name);
+	if (file == entry->second.end())
+	{
+		return;
+	}
+
+	// Access time isn't journaled, as losing it isn't critical
+	file->second.last_access = lib::date_time::seconds_since_epoch();
+	changed = true;
+}
+
+auto lib::cache_manifest::get(const std::string &type, const std::string &name,
+	cache_entry &entry) const -> bool
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto files = entries.find(type);
+	if (files == entries.end())
+	{
+		return false;
+	}
+
+	auto file = files->second.find(name);
+	if (file == files->second.end())
+	{
+		return false;
+	}
+
+	entry = file->second;
+	return true;
+}
+
+auto lib::cache_manifest::names(const std::string &type) const -> std::vector<std::string>
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	std::vector<std::string> results;
+
+	auto entry = entries.find(type);
+	if (entry == entries.end())
+	{
+		return results;
+	}
+
+	results.reserve(entry->second.size());
+	for (const auto &file : entry->second)
+	{
+		results.push_back(file.first);
+	}
+	return results;
+}
+
+auto lib::cache_manifest::usage(const std::string &type) const -> cache_usage
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto result = usages.find(type);
+	return result == usages.end()
+		? cache_usage()
+		: result->second;
+}
+
+auto lib::cache_manifest::usage() const -> std::map<std::string, cache_usage>
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return usages;
+}
+
+auto lib::cache_manifest::least_recently_used(const std::string &type,
+	size_t max_size) const -> std::vector<std::string>
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	std::vector<std::string> results;
+
+	auto usage = usages.find(type);
+	auto entry = entries.find(type);
+	auto total = usage == usages.end()
+		? 0
+		: usage->second.size;
+	if (total <= max_size || entry == entries.end())
+	{
+		return results;
+	}
+
+	std::vector<std::pair<std::string, cache_entry>> files(entry->second.begin(),
+		entry->second.end());
+	std::sort(files.begin(), files.end(),
+		[](const std::pair<std::string, cache_entry> &file1,
+			const std::pair<std::string, cache_entry> &file2) -> bool
+		{
+			return file1.second.last_access < file2.second.last_access;
+		});
+
+	for (const auto &file : files)
+	{
+		if (total <= max_size)
+		{
+			break;
+		}
+
+		results.push_back(file.first);
+		total -= file.second.size;
+	}
+
+	return results;
+}
+
+void lib::cache_manifest::save()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	write();
+}
+
+void lib::cache_manifest::write()
+{
+	if (read_only)
+	{
+		return;
+	}
+
+	nlohmann::json json{
+		{"version", manifest_version},
+		{"entries", entries},
+	};
+
+	// Written to a temporary file first, so a crash never leaves a partial manifest
+	auto temp_path = manifest_path();
+	temp_path += ".tmp";
+
+	try
+	{
+		if (!ghc::filesystem::exists(dir))
+		{
+			ghc::filesystem::create_directories(dir);
+		}
+
+		{
+			std::ofstream file(temp_path);
+			file << json;
+			if (!file.good())
+			{
+				lib::log::warn("Failed to save cache manifest: Failed to write file");
+				return;
+			}
+		}
+
+		ghc::filesystem::rename(temp_path, manifest_path());
+		ghc::filesystem::remove(journal_path());
+	}
+	catch (const std::exception &e)
+	{
+		lib::log::warn("Failed to save cache manifest: {}", e.what());
+		std::error_code error;
+		ghc::filesystem::remove(temp_path, error);
+		return;
+	}
+
+	changed = false;
+	journal_size = 0;
+}
+
+auto lib::cache_manifest::manifest_path() const -> ghc::filesystem::path
+{
+	return dir / "manifest.json";
+}
+
+auto lib::cache_manifest::journal_path() const -> ghc::filesystem::path
+{
+	return dir / "manifest.journal";
+}
+
+auto lib::cache_manifest::load() -> bool
+{
+	std::ifstream file(manifest_path());
+	if (!file.is_open() || file.bad())
+	{
+		return false;
+	}
+
+	try
+	{
+		nlohmann::json json;
+		file >> json;
+
+		if (json.at("version").get<int>() != manifest_version)
+		{
+			return false;
+		}
+
+		const auto &all = json.at("entries");
+		for (auto type = all.cbegin(); type != all.cend(); type++)
+		{
+			for (auto name = type.value().cbegin(); name != type.value().cend(); name++)
+			{
+				set(type.key(), name.key(), name.value().get<cache_entry>());
+			}
+		}
+	}
+	catch (const std::exception &e)
+	{
+		lib::log::warn("Failed to load cache manifest, rebuilding: {}", e.what());
+		entries.clear();
+		usages.clear();
+		return false;
+	}
+
+	// Replay changes not yet merged into manifest
+	std::ifstream journal_file(journal_path());
+	std::string line;
+	while (std::getline(journal_file, line))
+	{
+		try
+		{
+			auto json = nlohmann::json::parse(line);
+			const auto &type = json.at("type").get<std::string>();
+			const auto &name = json.at("name").get<std::string>();
+
+			if (json.contains("entry"))
+			{
+				set(type, name, json.at("entry").get<cache_entry>());
+			}
+			else
+			{
+				unset(type, name);
+			}
+			changed = true;
+			journal_size++;
+		}
+		catch (const std::exception &e)
+		{
+			// Probably interrupted while writing, ignore
+			lib::log::warn("Invalid cache journal entry: {}", e.what());
+		}
+	}
+
+	return true;
+}
+
+void lib::cache_manifest::rebuild()
+{
+	entries.clear();
+	usages.clear();
+
+	for (const auto &type : types)
+	{
+		std::error_code error;
+		auto type_dir = dir / type;
+		if (!ghc::filesystem::exists(type_dir, error))
+		{
+			continue;
+		}
+
+		// Entries that can't be read are skipped, instead of failing to start
+		ghc::filesystem::directory_iterator file(type_dir, error);
+		for (; !error && file != ghc::filesystem::directory_iterator(); file.increment(error))
+		{
+			// Unfinished writes are not part of the cache
+			std::error_code file_error;
+			if (!file->is_regular_file(file_error)
+				|| file->path().extension() == ".tmp")
+			{
+				continue;
+			}
+
+			cache_entry entry;
+			entry.size = file->file_size(file_error);
+			const auto write_time = file->last_write_time(file_error);
+			if (file_error)
+			{
+				lib::log::warn("Failed to read cache entry {}: {}",
+					file->path().string(), file_error.message());
+				continue;
+			}
+
+			entry.last_access = static_cast<long>(std::chrono::duration_cast<std::chrono::seconds>
+				(write_time.time_since_epoch()).count());
+
+			set(type, file->path().filename().string(), entry);
+		}
+
+		if (error)
+		{
+			lib::log::warn("Failed to read cache directory {}: {}",
+				type_dir.string(), error.message());
+		}
+	}
+
+	changed = true;
+}
+
+void lib::cache_manifest::set(const std::string &type, const std::string &name,
+	const cache_entry &entry)
+{
+	auto &files = entries[type];
+	auto &total = usages[type];
+
+	auto file = files.find(name);
+	if (file == files.end())
+	{
+		total.count++;
+	}
+	else
+	{
+		total.size -= file->second.size;
+	}
+
+	total.size += entry.size;
+	files[name] = entry;
+}
+
+void lib::cache_manifest::unset(const std::string &type, const std::string &name)
+{
+	auto files = entries.find(type);
+	if (files == entries.end())
+	{
+		return;
+	}
+
+	auto file = files->second.find(name);
+	if (file == files->second.end())
+	{
+		return;
+	}
+
+	auto &total = usages[type];
+	total.count--;
+	total.size -= file->second.size;
+	files->second.erase(file);
+}
+
+void lib::cache_manifest::journal(const nlohmann::json &json)
+{
+	changed = true;
+
+	if (read_only)
+	{
+		return;
+	}
+
+	if (++journal_size > max_journal_size)
+	{
+		write();
+		return;
+	}
+
+	try
+	{
+		std::ofstream file(journal_path(), std::ios::app);
+		file << json << '\n';
+	}
+	catch (const std::exception &e)
+	{
+		lib::log::warn("Failed to write cache journal: {}", e.what());
+	}
+}
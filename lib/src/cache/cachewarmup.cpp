@@ -0,0 +1,46 @@
+#include "lib/cache/cachewarmup.hpp"
+#include "lib/spotify/api.hpp"
+
+lib::cache_warm_up::cache_warm_up(const lib::cache &cache,
+	const std::string &last_playlist)
+{
+	playlists_future = std::async(std::launch::async, [&cache]()
+	{
+		return cache.get_playlists();
+	});
+
+	const auto playlist_id = lib::spt::api::to_id(last_playlist);
+	last_playlist_future = std::async(std::launch::async, [&cache, playlist_id]()
+	{
+		return playlist_id.empty()
+			? lib::spt::playlist()
+			: cache.get_playlist(playlist_id);
+	});
+
+	liked_tracks_future = std::async(std::launch::async, [&cache]()
+	{
+		return cache.get_tracks(liked_tracks_id);
+	});
+}
+
+void lib::cache_warm_up::wait() const
+{
+	playlists_future.wait();
+	last_playlist_future.wait();
+	liked_tracks_future.wait();
+}
+
+auto lib::cache_warm_up::playlists() const -> std::vector<lib::spt::playlist>
+{
+	return playlists_future.get();
+}
+
+auto lib::cache_warm_up::last_playlist() const -> lib::spt::playlist
+{
+	return last_playlist_future.get();
+}
+
+auto lib::cache_warm_up::liked_tracks() const -> std::vector<lib::spt::track>
+{
+	return liked_tracks_future.get();
+}
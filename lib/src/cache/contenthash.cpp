@@ -0,0 +1,83 @@
+#include "lib/cache/contenthash.hpp"
+
+auto lib::content_hash::get(const std::vector<lib::spt::track> &tracks) -> std::uint64_t
+{
+	auto hash = add(lib::hash::offset_basis, tracks.size());
+	for (const auto &track : tracks)
+	{
+		hash = add(hash, track);
+	}
+	return hash;
+}
+
+auto lib::content_hash::get(const lib::spt::playlist &playlist) -> std::uint64_t
+{
+	return add(lib::hash::offset_basis, playlist);
+}
+
+auto lib::content_hash::get(const std::vector<lib::spt::playlist> &playlists) -> std::uint64_t
+{
+	auto hash = add(lib::hash::offset_basis, playlists.size());
+	for (const auto &playlist : playlists)
+	{
+		hash = add(hash, playlist);
+	}
+	return hash;
+}
+
+auto lib::content_hash::add(std::uint64_t hash, const std::string &value) -> std::uint64_t
+{
+	// Length is included so "ab", "c" and "a", "bc" differ
+	return lib::hash::fnv1a(value, add(hash, value.size()));
+}
+
+auto lib::content_hash::add(std::uint64_t hash, size_t value) -> std::uint64_t
+{
+	return lib::hash::fnv1a(&value, sizeof(value), hash);
+}
+
+auto lib::content_hash::add(std::uint64_t hash, const lib::spt::entity &entity) -> std::uint64_t
+{
+	hash = add(hash, entity.id);
+	return add(hash, entity.name);
+}
+
+auto lib::content_hash::add(std::uint64_t hash, const lib::spt::track &track) -> std::uint64_t
+{
+	hash = add(hash, static_cast<const lib::spt::entity &>(track));
+	hash = add(hash, static_cast<size_t>(track.is_local));
+	hash = add(hash, static_cast<size_t>(track.is_playable));
+	hash = add(hash, static_cast<size_t>(track.duration));
+	hash = add(hash, track.added_at);
+	hash = add(hash, track.album);
+	hash = add(hash, track.image);
+
+	hash = add(hash, track.artists.size());
+	for (const auto &artist : track.artists)
+	{
+		hash = add(hash, artist);
+	}
+
+	return hash;
+}
+
+auto lib::content_hash::add(std::uint64_t hash, const lib::spt::playlist &playlist) -> std::uint64_t
+{
+	hash = add(hash, playlist.id);
+	hash = add(hash, playlist.name);
+	hash = add(hash, playlist.description);
+	hash = add(hash, playlist.image);
+	hash = add(hash, playlist.snapshot);
+	hash = add(hash, playlist.owner_id);
+	hash = add(hash, playlist.owner_name);
+	hash = add(hash, static_cast<size_t>(playlist.collaborative));
+	hash = add(hash, static_cast<size_t>(playlist.is_public));
+
+	hash = add(hash, playlist.tracks.size());
+	for (const auto &track : playlist.tracks)
+	{
+		hash = add(hash, track);
+	}
+
+	return hash;
+}
@@ -1,34 +1,59 @@
-
 #include "lib/cache/jsoncache.hpp"
+#include "lib/image.hpp"
+
+constexpr int lib::json_cache::schema_version;
 
-lib::json_cache::json_cache(const lib::paths &paths)
-	: paths(paths),
-	cache()
+lib::json_cache::json_cache(const lib::paths &paths, bool read_only)
+	: cache(),
+	paths(paths),
+	manifest(paths.cache(), types(), read_only),
+	written(0),
+	skipped(0)
 {
+	for (const auto &type : types())
+	{
+		auto path = paths.cache() / type;
+		dirs.emplace(type, path);
+
+		// Missing directories are treated as empty
+		if (read_only)
+		{
+			continue;
+		}
+
+		std::error_code error;
+		ghc::filesystem::create_directories(path, error);
+		if (error)
+		{
+			log::warn("Failed to create cache directory \"{}\": {}",
+				path.string(), error.message());
+		}
+	}
 }
 
 //region album
 
 auto lib::json_cache::get_album_image(const std::string &url) const -> std::vector<unsigned char>
 {
-	std::ifstream file(path("album", get_url_id(url), ""),
-		std::ios::binary);
-	if (!file.is_open() || file.bad())
-	{
-		return std::vector<unsigned char>();
-	}
-
-	return std::vector<unsigned char>(std::istreambuf_iterator<char>(file),
-		std::istreambuf_iterator<char>());
+	return read_binary("album", file(get_url_id(url), ""));
 }
 
 void lib::json_cache::set_album_image(const std::string &url,
 	const std::vector<unsigned char> &data)
 {
-	std::ofstream file(path("album", get_url_id(url), ""),
-		std::ios::binary);
-	std::copy(data.begin(), data.end(),
-		std::ostream_iterator<char>(file));
+	write_binary("album", file(get_url_id(url), ""), data);
+}
+
+auto lib::json_cache::get_album_image(const std::string &url,
+	int size) const -> std::vector<unsigned char>
+{
+	return read_binary("album", file(get_url_id(url), std::to_string(size)));
+}
+
+void lib::json_cache::set_album_image(const std::string &url, int size,
+	const std::vector<unsigned char> &data)
+{
+	write_binary("album", file(get_url_id(url), std::to_string(size)), data);
 }
 
 //endregion
@@ -39,7 +64,7 @@ auto lib::json_cache::get_playlists() const -> std::vector<lib::spt::playlist>
 {
 	try
 	{
-		return json::load(path("playlist", "playlists", "json"));
+		return load_json("playlist", "playlists");
 	}
 	catch (const std::exception &e)
 	{
@@ -51,7 +76,11 @@ auto lib::json_cache::get_playlists() const -> std::vector<lib::spt::playlist>
 
 void lib::json_cache::set_playlists(const std::vector<spt::playlist> &playlists)
 {
-	lib::json::save(path("playlist", "playlists", "json"), playlists);
+	save_json("playlist", "playlists", lib::content_hash::get(playlists),
+		[&playlists]() -> nlohmann::json
+		{
+			return playlists;
+		});
 }
 
 //endregion
@@ -62,7 +91,25 @@ auto lib::json_cache::get_playlist(const std::string &id) const -> lib::spt::pla
 {
 	try
 	{
-		return json::load(path("playlist", id, "json"));
+		auto json = load_json("playlist", id);
+		if (json.is_null())
+		{
+			return lib::spt::playlist();
+		}
+
+		auto tracks = json.find("tracks");
+		if (tracks == json.end()
+			|| !lib::normalized_tracks::is_normalized(*tracks))
+		{
+			return json;
+		}
+
+		auto tracks_list = lib::normalized_tracks::from_json(*tracks);
+		json.erase(tracks);
+
+		lib::spt::playlist playlist = json;
+		playlist.tracks = std::move(tracks_list);
+		return playlist;
 	}
 	catch (const std::exception &e)
 	{
@@ -74,7 +121,13 @@ auto lib::json_cache::get_playlist(const std::string &id) const -> lib::spt::pla
 
 void lib::json_cache::set_playlist(const spt::playlist &playlist)
 {
-	lib::json::save(path("playlist", playlist.id, "json"), playlist);
+	save_json("playlist", playlist.id, lib::content_hash::get(playlist),
+		[&playlist]() -> nlohmann::json
+		{
+			nlohmann::json json = playlist;
+			json["tracks"] = lib::normalized_tracks::to_json(playlist.tracks);
+			return json;
+		});
 }
 
 //endregion
@@ -83,31 +136,29 @@ void lib::json_cache::set_playlist(const spt::playlist &playlist)
 
 auto lib::json_cache::get_tracks(const std::string &id) const -> std::vector<lib::spt::track>
 {
-	return lib::json::load<std::vector<lib::spt::track>>(path("tracks", id, "json"));
+	return lib::normalized_tracks::from_json(load_json("tracks", id));
 }
 
 void lib::json_cache::set_tracks(const std::string &id, const std::vector<lib::spt::track> &tracks)
 {
-	lib::json::save(path("tracks", id, "json"), tracks);
+	save_json("tracks", id, lib::content_hash::get(tracks),
+		[&tracks]() -> nlohmann::json
+		{
+			return lib::normalized_tracks::to_json(tracks);
+		});
 }
 
-auto lib::json_cache::all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>>
+void lib::json_cache::all_tracks(const std::function<bool(const std::string &id,
+	const std::vector<lib::spt::track> &tracks)> &callback) const
 {
-	auto dir = ghc::filesystem::path(paths.cache()) / "tracks";
-	std::map<std::string, std::vector<lib::spt::track>> results;
-
-	if (!ghc::filesystem::exists(dir))
+	for (const auto &name : manifest.names("tracks"))
 	{
-		return results;
+		auto id = ghc::filesystem::path(name).replace_extension().string();
+		if (!callback(id, get_tracks(id)))
+		{
+			break;
+		}
 	}
-
-	for (const auto &entry : ghc::filesystem::directory_iterator(dir))
-	{
-		auto id = entry.path().filename().replace_extension().string();
-		results[id] = get_tracks(id);
-	}
-
-	return results;
 }
 
 //endregion
@@ -116,13 +167,18 @@ auto lib::json_cache::all_tracks() const -> std::map<std::string, std::vector<li
 
 auto lib::json_cache::get_track_info(const lib::spt::track &track) const -> lib::spt::track_info
 {
-	return lib::json::load(path("trackInfo", track.id, "json"));
+	auto json = load_json("trackInfo", track.id);
+	if (json.is_null())
+	{
+		return lib::spt::track_info();
+	}
+	return json;
 }
 
 void lib::json_cache::set_track_info(const lib::spt::track &track,
 	const lib::spt::track_info &track_info)
 {
-	lib::json::save(path("trackInfo", track.id, "json"), track_info);
+	save_json("trackInfo", track.id, track_info);
 }
 
 //endregion
@@ -132,41 +188,332 @@ void lib::json_cache::set_track_info(const lib::spt::track &track,
 void lib::json_cache::add_crash(const lib::crash_info &info)
 {
 	auto file_name = lib::date_time::now().to_iso_date_time();
-	lib::json::save(path("crash", file_name, "json"), info);
+	save_json("crash", file_name, info);
 }
 
 auto lib::json_cache::get_all_crashes() const -> std::vector<lib::crash_info>
 {
-	auto dir = ghc::filesystem::path(paths.cache()) / "crash";
 	std::vector<lib::crash_info> results;
 
-	if (!ghc::filesystem::exists(dir))
+	for (const auto &name : manifest.names("crash"))
 	{
-		return results;
+		results.push_back(lib::json::load<lib::crash_info>(dir("crash") / name));
 	}
 
-	for (const auto &entry : ghc::filesystem::directory_iterator(dir))
+	return results;
+}
+
+//endregion
+
+//region usage
+
+auto lib::json_cache::get_usage() const -> std::map<std::string, lib::cache_usage>
+{
+	return manifest.usage();
+}
+
+auto lib::json_cache::get_writes() const -> lib::cache_writes
+{
+	lib::cache_writes writes;
+	writes.written = written;
+	writes.skipped = skipped;
+	return writes;
+}
+
+auto lib::json_cache::evict(const std::string &type, size_t max_size) -> size_t
+{
+	const auto names = manifest.least_recently_used(type, max_size);
+
+	for (const auto &name : names)
 	{
-		results.push_back(lib::json::load<lib::crash_info>(entry.path()));
+		std::lock_guard<std::mutex> lock(write_lock(type, name));
+
+		std::error_code error;
+		ghc::filesystem::remove(dir(type) / name, error);
+		manifest.remove(type, name);
 	}
 
-	return results;
+	return names.size();
+}
+
+//endregion
+
+//region maintenance
+
+auto lib::json_cache::verify(bool repair) -> std::vector<lib::cache_issue>
+{
+	std::vector<lib::cache_issue> issues;
+	std::unordered_set<std::string> album_ids;
+
+	for (const auto &type : types())
+	{
+		// Album images are checked last, when all used albums are known
+		if (type == "album")
+		{
+			continue;
+		}
+
+		for (const auto &name : file_names(type))
+		{
+			const auto reason = verify_file(type, name, album_ids);
+			if (!reason.empty())
+			{
+				issues.emplace_back(type, name, reason);
+			}
+		}
+	}
+
+	for (const auto &name : file_names("album"))
+	{
+		auto reason = verify_file("album", name, album_ids);
+		if (reason.empty()
+			&& album_ids.find(name) == album_ids.end()
+			&& album_ids.find(ghc::filesystem::path(name).stem().string()) == album_ids.end())
+		{
+			reason = "Not used by any cached track";
+		}
+
+		if (!reason.empty())
+		{
+			issues.emplace_back("album", name, reason);
+		}
+	}
+
+	if (!repair)
+	{
+		return issues;
+	}
+
+	for (const auto &issue : issues)
+	{
+		std::lock_guard<std::mutex> lock(write_lock(issue.type, issue.name));
+
+		std::error_code error;
+		ghc::filesystem::remove(dir(issue.type) / issue.name, error);
+		manifest.remove(issue.type, issue.name);
+	}
+
+	// Entries where the file was removed outside the cache
+	for (const auto &type : types())
+	{
+		for (const auto &name : manifest.names(type))
+		{
+			if (!ghc::filesystem::exists(dir(type) / name))
+			{
+				manifest.remove(type, name);
+			}
+		}
+	}
+
+	return issues;
+}
+
+auto lib::json_cache::compact() -> size_t
+{
+	size_t count = 0;
+
+	for (const auto &type : types())
+	{
+		// Images are already compressed
+		if (type == "album")
+		{
+			continue;
+		}
+
+		for (const auto &name : manifest.names(type))
+		{
+			lib::cache_entry entry;
+			if (manifest.get(type, name, entry) && entry.version >= schema_version)
+			{
+				continue;
+			}
+
+			const auto id = ghc::filesystem::path(name).replace_extension().string();
+
+			// Saved through normal setters, to also save content hash
+			if (type == "tracks")
+			{
+				const auto tracks = get_tracks(id);
+				if (tracks.empty())
+				{
+					continue;
+				}
+				set_tracks(id, tracks);
+			}
+			else if (type == "playlist" && id == "playlists")
+			{
+				const auto playlists = get_playlists();
+				if (playlists.empty())
+				{
+					continue;
+				}
+				set_playlists(playlists);
+			}
+			else if (type == "playlist")
+			{
+				const auto playlist = get_playlist(id);
+				if (playlist.is_null())
+				{
+					continue;
+				}
+				set_playlist(playlist);
+			}
+			else
+			{
+				const auto json = load_json(type, id);
+				if (json.is_null())
+				{
+					continue;
+				}
+				save_json(type, id, json);
+			}
+
+			count++;
+		}
+	}
+
+	return count;
 }
 
 //endregion
 
 //region private
 
-auto lib::json_cache::dir(const std::string &type) const -> ghc::filesystem::path
+auto lib::json_cache::types() -> const std::vector<std::string> &
 {
-	auto file_dir = ghc::filesystem::path(paths.cache()) / type;
+	static const std::vector<std::string> types{
+		"album", "playlist", "tracks", "trackInfo", "crash",
+	};
+	return types;
+}
+
+auto lib::json_cache::dir(const std::string &type) const -> const ghc::filesystem::path &
+{
+	return dirs.at(type);
+}
 
-	if (!ghc::filesystem::exists(file_dir))
+auto lib::json_cache::open_write(const std::string &type, const std::string &name,
+	std::ios::openmode mode) const -> std::ofstream
+{
+	const auto &file_dir = dir(type);
+	std::ofstream file(file_dir / name, mode);
+	if (file.is_open())
 	{
-		ghc::filesystem::create_directories(file_dir);
+		return file;
 	}
 
-	return file_dir;
+	// Only check directory if opening failed, as it's rarely removed
+	std::error_code error;
+	ghc::filesystem::create_directories(file_dir, error);
+	return std::ofstream(file_dir / name, mode);
+}
+
+auto lib::json_cache::file_names(const std::string &type) const -> std::vector<std::string>
+{
+	std::vector<std::string> names;
+
+	std::error_code error;
+	for (const auto &entry : ghc::filesystem::directory_iterator(dir(type), error))
+	{
+		if (entry.is_regular_file())
+		{
+			names.push_back(entry.path().filename().string());
+		}
+	}
+
+	return names;
+}
+
+auto lib::json_cache::verify_file(const std::string &type, const std::string &name,
+	std::unordered_set<std::string> &album_ids) const -> std::string
+{
+	if (ghc::filesystem::path(name).extension() == ".tmp")
+	{
+		return "Unfinished write";
+	}
+
+	// Not read using read_binary, to keep access time
+	std::vector<unsigned char> data;
+	lib::json::read_file(dir(type) / name, data);
+
+	lib::cache_entry entry;
+	if (manifest.get(type, name, entry)
+		&& entry.hash != 0
+		&& entry.hash != lib::hash::fnv1a(data.data(), data.size()))
+	{
+		return "Content does not match manifest";
+	}
+
+	if (type == "album")
+	{
+		return lib::image::is_jpeg(data)
+			? std::string()
+			: "Not a JPEG image";
+	}
+
+	try
+	{
+		const auto json = nlohmann::json::parse(data.begin(), data.end());
+		const auto add_albums = [&album_ids](const std::vector<lib::spt::track> &tracks)
+		{
+			for (const auto &track : tracks)
+			{
+				if (!track.image.empty())
+				{
+					album_ids.insert(get_url_id(track.image));
+				}
+			}
+		};
+
+		if (type == "tracks")
+		{
+			if (!json.is_array() && !lib::normalized_tracks::is_normalized(json))
+			{
+				return "Not a list of tracks";
+			}
+			add_albums(lib::normalized_tracks::from_json(json));
+		}
+		else if (type == "playlist" && name == "playlists.json")
+		{
+			if (!json.is_array())
+			{
+				return "Not a list of playlists";
+			}
+			for (const auto &playlist : json.get<std::vector<lib::spt::playlist>>())
+			{
+				add_albums(playlist.tracks);
+			}
+		}
+		else if (type == "playlist")
+		{
+			if (!json.is_object())
+			{
+				return "Not a playlist";
+			}
+			const auto tracks = json.find("tracks");
+			if (tracks != json.end())
+			{
+				add_albums(lib::normalized_tracks::from_json(*tracks));
+			}
+			auto playlist = json;
+			playlist.erase("tracks");
+			playlist.get<lib::spt::playlist>();
+		}
+		else if (type == "trackInfo")
+		{
+			json.get<lib::spt::track_info>();
+		}
+		else if (type == "crash")
+		{
+			json.get<lib::crash_info>();
+		}
+	}
+	catch (const std::exception &e)
+	{
+		return e.what();
+	}
+
+	return std::string();
 }
 
 auto lib::json_cache::file(const std::string &id,
@@ -177,15 +524,150 @@ auto lib::json_cache::file(const std::string &id,
 		: fmt::format("{}.{}", id, extension);
 }
 
-auto lib::json_cache::path(const std::string &type, const std::string &id,
-	const std::string &extension) const -> ghc::filesystem::path
+auto lib::json_cache::load_json(const std::string &type,
+	const std::string &id) const -> nlohmann::json
 {
-	return dir(type) / file(id, extension);
+	const auto name = file(id, "json");
+	manifest.touch(type, name);
+	return lib::json::load(dir(type) / name);
 }
 
-auto lib::json_cache::get_url_id(const ghc::filesystem::path &path) -> std::string
+void lib::json_cache::save_json(const std::string &type, const std::string &id,
+	const nlohmann::json &json)
 {
-	return path.stem();
+	const auto name = file(id, "json");
+	std::lock_guard<std::mutex> lock(write_lock(type, name));
+
+	write_json(type, name, json, 0);
+}
+
+void lib::json_cache::save_json(const std::string &type, const std::string &id,
+	std::uint64_t content_hash, const std::function<nlohmann::json()> &get_json)
+{
+	const auto name = file(id, "json");
+	std::lock_guard<std::mutex> lock(write_lock(type, name));
+
+	if (is_unchanged(type, name, content_hash))
+	{
+		return;
+	}
+
+	write_json(type, name, get_json(), content_hash);
+}
+
+void lib::json_cache::write_json(const std::string &type, const std::string &name,
+	const nlohmann::json &json, std::uint64_t content_hash)
+{
+	// Not indented, as cache is not intended to be edited manually
+	const auto data = json.dump();
+	if (!write_file(type, name, data.data(), data.size()))
+	{
+		return;
+	}
+
+	manifest.update(type, name, data.size(), lib::hash::fnv1a(data),
+		schema_version, content_hash);
+	written++;
+}
+
+auto lib::json_cache::is_unchanged(const std::string &type, const std::string &name,
+	std::uint64_t content_hash) -> bool
+{
+	lib::cache_entry entry;
+	if (!manifest.get(type, name, entry)
+		|| entry.content_hash != content_hash
+		|| entry.version != schema_version
+		|| !ghc::filesystem::exists(dir(type) / name))
+	{
+		return false;
+	}
+
+	manifest.touch(type, name);
+	skipped++;
+	return true;
+}
+
+auto lib::json_cache::read_binary(const std::string &type,
+	const std::string &name) const -> std::vector<unsigned char>
+{
+	std::vector<unsigned char> data;
+	if (lib::json::read_file(dir(type) / name, data) && !data.empty())
+	{
+		manifest.touch(type, name);
+	}
+	return data;
+}
+
+void lib::json_cache::write_binary(const std::string &type, const std::string &name,
+	const std::vector<unsigned char> &data)
+{
+	std::lock_guard<std::mutex> lock(write_lock(type, name));
+
+	if (!write_file(type, name, reinterpret_cast<const char *>(data.data()), data.size()))
+	{
+		return;
+	}
+
+	manifest.update(type, name, data.size(),
+		lib::hash::fnv1a(data.data(), data.size()), schema_version);
+	written++;
+}
+
+auto lib::json_cache::write_file(const std::string &type, const std::string &name,
+	const char *data, size_t size) const -> bool
+{
+	// Written to a temporary file first, so readers never see a partial file
+	const auto temp_name = file(name, "tmp");
+
+	{
+		auto file = open_write(type, temp_name, std::ios::out | std::ios::binary);
+		if (!file.is_open())
+		{
+			log::warn("Failed to save \"{}\": Failed to open file", name);
+			return false;
+		}
+
+		file.write(data, static_cast<std::streamsize>(size));
+		if (!file.good())
+		{
+			log::warn("Failed to save \"{}\": Failed to write file", name);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	ghc::filesystem::rename(dir(type) / temp_name, dir(type) / name, error);
+	if (error)
+	{
+		log::warn("Failed to save \"{}\": {}", name, error.message());
+		ghc::filesystem::remove(dir(type) / temp_name, error);
+		return false;
+	}
+
+	return true;
+}
+
+auto lib::json_cache::write_lock(const std::string &type,
+	const std::string &name) const -> std::mutex &
+{
+	const auto hash = lib::hash::fnv1a(name, lib::hash::fnv1a(type));
+	return write_locks.at(hash % write_locks.size());
+}
+
+auto lib::json_cache::get_url_id(const std::string &url) -> std::string
+{
+	// Same as path::stem, without parsing the url as a path on every lookup
+	const auto start = url.find_last_of('/');
+	auto name = start == std::string::npos
+		? url
+		: url.substr(start + 1);
+
+	const auto end = name.find_last_of('.');
+	if (end != std::string::npos && end > 0 && name != "..")
+	{
+		name.resize(end);
+	}
+	return name;
 }
 
 //endregion
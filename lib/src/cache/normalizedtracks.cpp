@@ -0,0 +1,144 @@
+#include "lib/cache/normalizedtracks.hpp"
+#include "lib/json.hpp"
+
+#include <unordered_map>
+
+auto lib::normalized_tracks::to_json(const std::vector<lib::spt::track> &tracks) -> nlohmann::json
+{
+	auto artists = nlohmann::json::array();
+	auto albums = nlohmann::json::array();
+	auto items = nlohmann::json::array();
+
+	std::unordered_map<std::string, size_t> artist_indices;
+	std::unordered_map<std::string, size_t> album_indices;
+
+	for (const auto &track : tracks)
+	{
+		// Image is stored with album, as it's the album cover
+		const auto album_key = lib::fmt::format("{}\n{}\n{}",
+			track.album.id, track.album.name, track.image);
+
+		auto album = album_indices.find(album_key);
+		if (album == album_indices.end())
+		{
+			album = album_indices.emplace(album_key, albums.size()).first;
+			albums.push_back({
+				track.album.id, track.album.name, track.image,
+			});
+		}
+
+		auto track_artists = nlohmann::json::array();
+		for (const auto &entity : track.artists)
+		{
+			const auto artist_key = lib::fmt::format("{}\n{}",
+				entity.id, entity.name);
+
+			auto artist = artist_indices.find(artist_key);
+			if (artist == artist_indices.end())
+			{
+				artist = artist_indices.emplace(artist_key, artists.size()).first;
+				artists.push_back({
+					entity.id, entity.name,
+				});
+			}
+			track_artists.push_back(artist->second);
+		}
+
+		nlohmann::json item{
+			{"id", track.id},
+			{"name", track.name},
+			{"duration", track.duration},
+			{"album", album->second},
+			{"artists", track_artists},
+		};
+
+		// Only save non-default values
+		if (track.is_local)
+		{
+			item["is_local"] = true;
+		}
+		if (!track.is_playable)
+		{
+			item["is_playable"] = false;
+		}
+		if (!track.added_at.empty())
+		{
+			item["added_at"] = track.added_at;
+		}
+
+		items.push_back(item);
+	}
+
+	return {
+		{"artists", artists},
+		{"albums", albums},
+		{"tracks", items},
+	};
+}
+
+auto lib::normalized_tracks::from_json(const nlohmann::json &json) -> std::vector<lib::spt::track>
+{
+	std::vector<lib::spt::track> tracks;
+
+	// Older format, with entities in each track
+	if (json.is_array())
+	{
+		json.get_to(tracks);
+		return tracks;
+	}
+
+	if (!is_normalized(json))
+	{
+		return tracks;
+	}
+
+	std::vector<lib::spt::entity> artists;
+	const auto &artists_json = json.at("artists");
+	artists.reserve(artists_json.size());
+	for (const auto &artist_json : artists_json)
+	{
+		lib::spt::entity artist;
+		artist_json.at(0).get_to(artist.id);
+		artist_json.at(1).get_to(artist.name);
+		artists.push_back(artist);
+	}
+
+	const auto &albums = json.at("albums");
+	const auto &items = json.at("tracks");
+	tracks.reserve(items.size());
+
+	for (const auto &item : items)
+	{
+		lib::spt::track track;
+		item.at("id").get_to(track.id);
+		item.at("name").get_to(track.name);
+		item.at("duration").get_to(track.duration);
+		lib::json::get(item, "is_local", track.is_local);
+		lib::json::get(item, "is_playable", track.is_playable);
+		lib::json::get(item, "added_at", track.added_at);
+
+		const auto &album = albums.at(item.at("album").get<size_t>());
+		album.at(0).get_to(track.album.id);
+		album.at(1).get_to(track.album.name);
+		album.at(2).get_to(track.image);
+
+		const auto &track_artists = item.at("artists");
+		track.artists.reserve(track_artists.size());
+		for (const auto &artist : track_artists)
+		{
+			track.artists.push_back(artists.at(artist.get<size_t>()));
+		}
+
+		tracks.push_back(std::move(track));
+	}
+
+	return tracks;
+}
+
+auto lib::normalized_tracks::is_normalized(const nlohmann::json &json) -> bool
+{
+	return json.is_object()
+		&& json.contains("artists")
+		&& json.contains("albums")
+		&& json.contains("tracks");
+}
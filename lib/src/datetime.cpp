@@ -25,6 +25,12 @@ auto lib::date_time::parse(const std::string &value) -> lib::date_time
 {
 	lib::date_time date;
 
+	// Most dates from the API are in this format
+	if (date.parse_iso_date_time(value))
+	{
+		return date;
+	}
+
 	// First try to parse as full date and time
 	date.parse(value, ISO_DATE_TIME_FORMAT);
 
@@ -67,6 +73,60 @@ auto lib::date_time::seconds_since_epoch() -> long
 		.time_since_epoch()).count();
 }
 
+auto lib::date_time::from_seconds_since_epoch(long long seconds) -> date_time
+{
+	constexpr long long seconds_per_day = 24 * 60 * 60;
+
+	auto days = seconds / seconds_per_day;
+	auto time = seconds % seconds_per_day;
+	if (time < 0)
+	{
+		time += seconds_per_day;
+		days--;
+	}
+
+	// Civil from days, see https://howardhinnant.github.io/date_algorithms.html
+	days += 719468;
+	const auto era = (days >= 0 ? days : days - 146096) / 146097;
+	const auto day_of_era = days - era * 146097;
+	const auto year_of_era = (day_of_era - day_of_era / 1460
+		+ day_of_era / 36524 - day_of_era / 146096) / 365;
+	const auto day_of_year = day_of_era - (365 * year_of_era
+		+ year_of_era / 4 - year_of_era / 100);
+	const auto month_index = (5 * day_of_year + 2) / 153;
+	const auto day = day_of_year - (153 * month_index + 2) / 5 + 1;
+	const auto month = month_index < 10 ? month_index + 3 : month_index - 9;
+	const auto year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+
+	return date_time(static_cast<int>(year), static_cast<int>(month),
+		static_cast<int>(day), static_cast<int>(time / 3600),
+		static_cast<int>(time % 3600 / 60), static_cast<int>(time % 60));
+}
+
+auto lib::date_time::to_seconds_since_epoch() const -> long long
+{
+	if (!is_valid())
+	{
+		return 0;
+	}
+
+	// Days from civil, see https://howardhinnant.github.io/date_algorithms.html
+	const long long month = get_month();
+	const long long year = get_year() - (month <= 2 ? 1 : 0);
+	const auto era = (year >= 0 ? year : year - 399) / 400;
+	const auto year_of_era = year - era * 400;
+	const auto day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5
+		+ get_day() - 1;
+	const auto day_of_era = year_of_era * 365 + year_of_era / 4
+		- year_of_era / 100 + day_of_year;
+	const auto days = era * 146097 + day_of_era - 719468;
+
+	return days * 24 * 60 * 60
+		+ get_hour() * 3600
+		+ get_minute() * 60
+		+ get_second();
+}
+
 auto lib::date_time::is_valid() const -> bool
 {
 	return tm.tm_year > 0
@@ -80,6 +140,55 @@ void lib::date_time::parse(const std::string &value, const char *format)
 	ss >> std::get_time(&tm, format);
 }
 
+auto lib::date_time::parse_iso_date_time(const std::string &value) -> bool
+{
+	// yyyy-MM-ddTHH:mm:ssZ
+	constexpr size_t length = 20;
+	if (value.size() != length
+		|| value[4] != '-' || value[7] != '-' || value[10] != 'T'
+		|| value[13] != ':' || value[16] != ':' || value[19] != 'Z')
+	{
+		return false;
+	}
+
+	const auto number = [&value](size_t start, size_t count) -> int
+	{
+		auto result = 0;
+		for (auto i = start; i < start + count; i++)
+		{
+			if (value[i] < '0' || value[i] > '9')
+			{
+				return -1;
+			}
+			result = result * 10 + (value[i] - '0');
+		}
+		return result;
+	};
+
+	const auto year = number(0, 4);
+	const auto month = number(5, 2);
+	const auto day = number(8, 2);
+	const auto hour = number(11, 2);
+	const auto minute = number(14, 2);
+	const auto second = number(17, 2);
+
+	if (year < 0 || month < 1 || month > 12 || day < 1 || day > 31
+		|| hour < 0 || hour > 23 || minute < 0 || minute > 59
+		|| second < 0 || second > 60)
+	{
+		return false;
+	}
+
+	tm = std::tm{};
+	tm.tm_year = year - c_year_offset;
+	tm.tm_mon = month - 1;
+	tm.tm_mday = day;
+	tm.tm_hour = hour;
+	tm.tm_min = minute;
+	tm.tm_sec = second;
+	return is_valid();
+}
+
 auto lib::date_time::to_time() const -> std::string
 {
 	return format(LOCALE_TIME_FORMAT);
@@ -13,7 +13,7 @@ std::string fmt::time(int ms)
 		format("{}{}", s < 10 ? "0" : "", s % 60));
 }
 
-std::string fmt::size(unsigned int bytes)
+std::string fmt::size(std::uintmax_t bytes)
 {
 	if (bytes >= 1000000000)
 		return format("{} GB", bytes / 1000000000);
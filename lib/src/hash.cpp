@@ -0,0 +1,23 @@
+#include "lib/hash.hpp"
+
+constexpr std::uint64_t lib::hash::offset_basis;
+constexpr std::uint64_t lib::hash::prime;
+
+auto lib::hash::fnv1a(const void *data, size_t size, std::uint64_t seed) -> std::uint64_t
+{
+	const auto *bytes = static_cast<const unsigned char *>(data);
+	auto result = seed;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		result ^= bytes[i];
+		result *= prime;
+	}
+
+	return result;
+}
+
+auto lib::hash::fnv1a(const std::string &str, std::uint64_t seed) -> std::uint64_t
+{
+	return fnv1a(str.data(), str.size(), seed);
+}
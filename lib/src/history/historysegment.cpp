@@ -0,0 +1,339 @@
+#include "lib/history/historysegment.hpp"
+#include "lib/log.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+constexpr std::uint32_t lib::history_segment::magic;
+constexpr std::uint32_t lib::history_segment::version;
+constexpr std::uint8_t lib::history_segment::record_track;
+constexpr std::uint8_t lib::history_segment::record_play;
+constexpr std::uint8_t lib::history_segment::record_started_play;
+constexpr size_t lib::history_segment::max_size;
+
+lib::history_segment::history_segment(const ghc::filesystem::path &path)
+	: path(path)
+{
+	load();
+}
+
+void lib::history_segment::add(const lib::spt::track &track, std::int64_t played_at,
+	lib::play_source source)
+{
+	std::string data;
+
+	if (entries.empty() && tracks.empty())
+	{
+		write_uint(data, magic, 4);
+		write_uint(data, version, 4);
+	}
+
+	auto index = track_indices.find(track.id);
+	if (index == track_indices.end())
+	{
+		index = track_indices.emplace(track.id,
+			static_cast<std::uint32_t>(tracks.size())).first;
+		tracks.push_back(track);
+		write_track(data, track);
+	}
+
+	entry play{};
+	play.played_at = played_at;
+	play.track = index->second;
+	play.source = source;
+	insert(play);
+	write_play(data, play);
+
+	std::ofstream file(path, std::ios::binary | std::ios::app);
+	file.write(data.data(), static_cast<std::streamsize>(data.size()));
+	if (!file.good())
+	{
+		log::warn("Failed to save history to \"{}\"", path.string());
+	}
+}
+
+auto lib::history_segment::contains(const std::string &track_id, std::int64_t from,
+	std::int64_t to, lib::play_source source) const -> bool
+{
+	const auto index = track_indices.find(track_id);
+	if (index == track_indices.end())
+	{
+		return false;
+	}
+
+	auto iter = std::lower_bound(entries.begin(), entries.end(), from,
+		[](const entry &play, std::int64_t time) -> bool
+		{
+			return play.played_at < time;
+		});
+
+	for (; iter != entries.end() && iter->played_at <= to; iter++)
+	{
+		if (iter->track == index->second && iter->source == source)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void lib::history_segment::newest(std::int64_t from, std::int64_t to, size_t max_count,
+	std::vector<lib::history_play> &plays) const
+{
+	auto end = std::lower_bound(entries.begin(), entries.end(), to,
+		[](const entry &play, std::int64_t time) -> bool
+		{
+			return play.played_at < time;
+		});
+
+	while (end != entries.begin() && max_count > 0)
+	{
+		end--;
+		if (end->played_at < from)
+		{
+			break;
+		}
+
+		plays.emplace_back(end->played_at, tracks.at(end->track));
+		max_count--;
+	}
+}
+
+auto lib::history_segment::size() const -> size_t
+{
+	return entries.size();
+}
+
+void lib::history_segment::load()
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		return;
+	}
+
+	const std::vector<char> data((std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+	file.close();
+
+	if (data.empty())
+	{
+		return;
+	}
+
+	reader reader(data);
+	if (reader.uint(4) != magic || reader.uint(4) != version)
+	{
+		discard();
+		return;
+	}
+
+	auto valid_size = reader.position;
+
+	while (!reader.at_end())
+	{
+		const auto type = reader.uint(1);
+
+		if (type == record_track)
+		{
+			auto track = read_track(reader);
+			if (reader.failed)
+			{
+				break;
+			}
+			track_indices[track.id] = static_cast<std::uint32_t>(tracks.size());
+			tracks.push_back(std::move(track));
+		}
+		else if (type == record_play || type == record_started_play)
+		{
+			entry play{};
+			play.played_at = static_cast<std::int64_t>(reader.uint(8));
+			play.track = static_cast<std::uint32_t>(reader.uint(4));
+			play.source = type == record_started_play
+				? lib::play_source::started
+				: lib::play_source::finished;
+			if (reader.failed || play.track >= tracks.size())
+			{
+				break;
+			}
+			insert(play);
+		}
+		else
+		{
+			break;
+		}
+
+		valid_size = reader.position;
+	}
+
+	// Remove partially written record, so new records can be appended
+	if (valid_size < data.size())
+	{
+		log::warn("Removing {} invalid bytes from history segment \"{}\"",
+			data.size() - valid_size, path.string());
+
+		std::error_code error;
+		ghc::filesystem::resize_file(path, valid_size, error);
+	}
+}
+
+void lib::history_segment::discard() const
+{
+	// Kept next to the segment, as it might be from a newer version
+	auto invalid_path = path;
+	invalid_path += ".invalid";
+
+	log::warn("Invalid history segment, moving to \"{}\"", invalid_path.string());
+
+	std::error_code error;
+	ghc::filesystem::rename(path, invalid_path, error);
+	if (error)
+	{
+		// New plays must never be appended to an invalid file
+		ghc::filesystem::resize_file(path, 0, error);
+	}
+}
+
+void lib::history_segment::insert(const entry &play)
+{
+	// Plays are almost always added in order
+	if (entries.empty() || entries.back().played_at <= play.played_at)
+	{
+		entries.push_back(play);
+		return;
+	}
+
+	const auto position = std::upper_bound(entries.begin(), entries.end(), play.played_at,
+		[](std::int64_t time, const entry &other) -> bool
+		{
+			return time < other.played_at;
+		});
+	entries.insert(position, play);
+}
+
+void lib::history_segment::write_track(std::string &data, const lib::spt::track &track)
+{
+	write_uint(data, record_track, 1);
+	write_string(data, track.id);
+	write_string(data, track.name);
+	write_string(data, track.album.id);
+	write_string(data, track.album.name);
+	write_string(data, track.image);
+	write_uint(data, static_cast<std::uint32_t>(track.duration), 4);
+	write_uint(data, (track.is_local ? 1U : 0U) | (track.is_playable ? 2U : 0U), 1);
+
+	const auto artist_count = std::min<size_t>(track.artists.size(), max_size);
+	write_uint(data, artist_count, 2);
+	for (size_t i = 0; i < artist_count; i++)
+	{
+		write_string(data, track.artists[i].id);
+		write_string(data, track.artists[i].name);
+	}
+}
+
+void lib::history_segment::write_play(std::string &data, const entry &play)
+{
+	write_uint(data, play.source == lib::play_source::started
+		? record_started_play
+		: record_play, 1);
+	write_uint(data, static_cast<std::uint64_t>(play.played_at), 8);
+	write_uint(data, play.track, 4);
+}
+
+void lib::history_segment::write_uint(std::string &data, std::uint64_t value, size_t size)
+{
+	// Always little endian
+	for (size_t i = 0; i < size; i++)
+	{
+		data.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+	}
+}
+
+void lib::history_segment::write_string(std::string &data, const std::string &value)
+{
+	auto size = std::min<size_t>(value.size(), max_size);
+
+	// Cut before a UTF-8 continuation byte, to never split a character
+	while (size < value.size() && size > 0
+		&& (static_cast<unsigned char>(value[size]) & 0xc0U) == 0x80U)
+	{
+		size--;
+	}
+
+	write_uint(data, size, 2);
+	data.append(value, 0, size);
+}
+
+auto lib::history_segment::read_track(reader &reader) -> lib::spt::track
+{
+	lib::spt::track track;
+	track.id = reader.string();
+	track.name = reader.string();
+	track.album.id = reader.string();
+	track.album.name = reader.string();
+	track.image = reader.string();
+	track.duration = static_cast<int>(reader.uint(4));
+
+	const auto flags = reader.uint(1);
+	track.is_local = (flags & 1U) != 0;
+	track.is_playable = (flags & 2U) != 0;
+
+	const auto artist_count = reader.uint(2);
+	for (std::uint64_t i = 0; i < artist_count && !reader.failed; i++)
+	{
+		lib::spt::entity artist;
+		artist.id = reader.string();
+		artist.name = reader.string();
+		track.artists.push_back(artist);
+	}
+
+	return track;
+}
+
+//region reader
+
+lib::history_segment::reader::reader(const std::vector<char> &data)
+	: data(data)
+{
+}
+
+auto lib::history_segment::reader::uint(size_t size) -> std::uint64_t
+{
+	if (failed || position + size > data.size())
+	{
+		failed = true;
+		return 0;
+	}
+
+	std::uint64_t value = 0;
+	for (size_t i = 0; i < size; i++)
+	{
+		value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data.at(position + i)))
+			<< (i * 8);
+	}
+
+	position += size;
+	return value;
+}
+
+auto lib::history_segment::reader::string() -> std::string
+{
+	const auto size = static_cast<size_t>(uint(2));
+	if (failed || position + size > data.size())
+	{
+		failed = true;
+		return std::string();
+	}
+
+	std::string value(data.data() + position, size);
+	position += size;
+	return value;
+}
+
+auto lib::history_segment::reader::at_end() const -> bool
+{
+	return failed || position >= data.size();
+}
+
+//endregion
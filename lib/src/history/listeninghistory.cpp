@@ -0,0 +1,354 @@
+#include "lib/history/listeninghistory.hpp"
+#include "lib/datetime.hpp"
+#include "lib/format.hpp"
+#include "lib/json.hpp"
+#include "lib/log.hpp"
+
+#include <algorithm>
+#include <limits>
+
+constexpr int lib::listening_history::stats_version;
+constexpr int lib::listening_history::min_play_seconds;
+
+lib::listening_history::listening_history(const ghc::filesystem::path &dir)
+	: dir(dir)
+{
+	std::error_code error;
+	if (!ghc::filesystem::exists(dir, error))
+	{
+		return;
+	}
+
+	for (const auto &file: ghc::filesystem::directory_iterator(dir, error))
+	{
+		const auto key = parse_key(file.path().filename().string());
+		if (key > 0)
+		{
+			segments[key] = nullptr;
+		}
+	}
+}
+
+lib::listening_history::~listening_history()
+{
+	save_stats();
+}
+
+auto lib::listening_history::add(const lib::spt::track &track, std::int64_t played_at,
+	lib::play_source source) -> bool
+{
+	if (track.id.empty())
+	{
+		return false;
+	}
+
+	const auto contains = [this, &track](std::int64_t from, std::int64_t to,
+		lib::play_source from_source) -> bool
+	{
+		for (const auto key: {month_key(from), month_key(to)})
+		{
+			if (segments.find(key) != segments.end()
+				&& segment(key).contains(track.id, from, to, from_source))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// Same play added again, for example after restarting or syncing again
+	constexpr std::int64_t same_play = 10;
+	if (contains(played_at - same_play, played_at + same_play, source))
+	{
+		return false;
+	}
+
+	// Start and stop of the same play, from different sources, allowing for pauses.
+	// Only a stop after the start was counted as a play can match,
+	// so the same track playing again right after isn't merged.
+	constexpr std::int64_t pause = 60;
+	const std::int64_t duration = track.duration / 1000;
+	const auto min_played = std::min<std::int64_t>(min_play_seconds, duration / 2);
+
+	const auto other = source == lib::play_source::started
+		? contains(played_at + min_played, played_at + duration + pause,
+			lib::play_source::finished)
+		: contains(played_at - duration - pause, played_at - min_played,
+			lib::play_source::started);
+
+	if (other)
+	{
+		return false;
+	}
+
+	std::error_code error;
+	ghc::filesystem::create_directories(dir, error);
+	if (error)
+	{
+		log::warn("Failed to create history directory: {}", error.message());
+		return false;
+	}
+
+	const auto key = month_key(played_at);
+
+	// Statistics are only loaded when first needed, as it might require a rebuild
+	if (!stats_data && pending_sizes.find(key) == pending_sizes.end())
+	{
+		pending_sizes[key] = segment_size(key);
+	}
+
+	segment(key).add(track, played_at, source);
+
+	if (stats_data)
+	{
+		stats_data->add(track, played_at);
+		stats_sizes[key] = segment_size(key);
+		stats_changed = true;
+	}
+	else
+	{
+		pending_plays.emplace_back(played_at, track);
+	}
+
+	return true;
+}
+
+auto lib::listening_history::before(std::int64_t time, size_t count) const
+-> std::vector<lib::history_play>
+{
+	std::vector<lib::history_play> plays;
+
+	const auto key = month_key(time);
+	for (auto iter = segments.rbegin(); iter != segments.rend(); iter++)
+	{
+		if (plays.size() >= count)
+		{
+			break;
+		}
+		if (iter->first > key)
+		{
+			continue;
+		}
+
+		segment(iter->first).newest(std::numeric_limits<std::int64_t>::min(),
+			time, count - plays.size(), plays);
+	}
+
+	return plays;
+}
+
+auto lib::listening_history::month(int key) const -> std::vector<lib::history_play>
+{
+	std::vector<lib::history_play> plays;
+	if (segments.find(key) != segments.end())
+	{
+		const auto &current = segment(key);
+		plays.reserve(current.size());
+		current.newest(std::numeric_limits<std::int64_t>::min(),
+			std::numeric_limits<std::int64_t>::max(),
+			std::numeric_limits<size_t>::max(), plays);
+	}
+	return plays;
+}
+
+auto lib::listening_history::months() const -> std::vector<int>
+{
+	std::vector<int> keys;
+	keys.reserve(segments.size());
+
+	for (auto iter = segments.rbegin(); iter != segments.rend(); iter++)
+	{
+		keys.push_back(iter->first);
+	}
+
+	return keys;
+}
+
+auto lib::listening_history::newest() const -> std::int64_t
+{
+	std::vector<lib::history_play> plays;
+	for (auto iter = segments.rbegin(); iter != segments.rend() && plays.empty(); iter++)
+	{
+		segment(iter->first).newest(std::numeric_limits<std::int64_t>::min(),
+			std::numeric_limits<std::int64_t>::max(), 1, plays);
+	}
+
+	return plays.empty() ? 0 : plays.front().played_at;
+}
+
+auto lib::listening_history::month_key(std::int64_t time) -> int
+{
+	const auto date = lib::date_time::from_seconds_since_epoch(time);
+	return date.get_year() * 100 + date.get_month();
+}
+
+auto lib::listening_history::stats() const -> const lib::listening_stats &
+{
+	return load_stats();
+}
+
+void lib::listening_history::save_stats() const
+{
+	if (!stats_changed || !stats_data)
+	{
+		return;
+	}
+
+	std::error_code error;
+	if (!ghc::filesystem::exists(dir, error))
+	{
+		return;
+	}
+
+	nlohmann::json sizes = nlohmann::json::object();
+	for (const auto &size : stats_sizes)
+	{
+		sizes[std::to_string(size.first)] = size.second;
+	}
+
+	lib::json::save(stats_path(), {
+		{"version", stats_version},
+		{"segments", sizes},
+		{"stats", *stats_data},
+	});
+
+	stats_changed = false;
+}
+
+auto lib::listening_history::load_stats() const -> lib::listening_stats &
+{
+	if (stats_data)
+	{
+		return *stats_data;
+	}
+
+	const auto utc_offset = lib::listening_stats::local_utc_offset();
+
+	try
+	{
+		const auto json = lib::json::parse_file(stats_path());
+		if (json.is_object()
+			&& json.at("version").get<int>() == stats_version)
+		{
+			auto stats = json.at("stats").get<lib::listening_stats>();
+			const auto &sizes = json.at("segments");
+
+			// Out of date if any segment was changed since saved,
+			// except for plays added before loading
+			auto valid = stats.get_utc_offset() == utc_offset;
+
+			for (auto iter = sizes.cbegin(); valid && iter != sizes.cend(); iter++)
+			{
+				valid = segments.find(std::stoi(iter.key())) != segments.end();
+			}
+
+			for (auto iter = segments.begin(); valid && iter != segments.end(); iter++)
+			{
+				const auto key = std::to_string(iter->first);
+				const auto pending = pending_sizes.find(iter->first);
+				const auto expected = pending == pending_sizes.end()
+					? segment_size(iter->first)
+					: pending->second;
+
+				valid = sizes.contains(key)
+					? sizes.at(key).get<std::uintmax_t>() == expected
+					: expected == 0;
+			}
+
+			if (valid)
+			{
+				for (const auto &play : pending_plays)
+				{
+					stats.add(play.track, play.played_at);
+				}
+				for (const auto &current : segments)
+				{
+					stats_sizes[current.first] = segment_size(current.first);
+				}
+
+				stats_changed = !pending_plays.empty();
+				pending_plays.clear();
+				pending_sizes.clear();
+
+				stats_data.reset(new lib::listening_stats(std::move(stats)));
+				return *stats_data;
+			}
+		}
+	}
+	catch (const std::exception &e)
+	{
+		log::warn("Failed to load listening statistics: {}", e.what());
+	}
+
+	// Missing or out of date, go through all plays once
+	stats_data.reset(new lib::listening_stats(utc_offset));
+	stats_sizes.clear();
+	pending_plays.clear();
+	pending_sizes.clear();
+
+	for (const auto &current : segments)
+	{
+		for (const auto &play : month(current.first))
+		{
+			stats_data->add(play.track, play.played_at);
+		}
+		stats_sizes[current.first] = segment_size(current.first);
+	}
+
+	stats_changed = true;
+	save_stats();
+
+	return *stats_data;
+}
+
+auto lib::listening_history::stats_path() const -> ghc::filesystem::path
+{
+	return dir / "stats.json";
+}
+
+auto lib::listening_history::segment(int key) const -> lib::history_segment &
+{
+	auto &current = segments[key];
+	if (!current)
+	{
+		current.reset(new lib::history_segment(segment_path(key)));
+	}
+	return *current;
+}
+
+auto lib::listening_history::segment_path(int key) const -> ghc::filesystem::path
+{
+	return dir / lib::fmt::format("{}-{}{}.bin", key / 100,
+		key % 100 < 10 ? "0" : "", key % 100);
+}
+
+auto lib::listening_history::segment_size(int key) const -> std::uintmax_t
+{
+	std::error_code error;
+	const auto size = ghc::filesystem::file_size(segment_path(key), error);
+	return error ? 0 : size;
+}
+
+auto lib::listening_history::parse_key(const std::string &file_name) -> int
+{
+	// yyyy-mm.bin
+	if (file_name.size() != 11
+		|| file_name[4] != '-'
+		|| file_name.substr(7) != ".bin")
+	{
+		return 0;
+	}
+
+	try
+	{
+		const auto year = std::stoi(file_name.substr(0, 4));
+		const auto month = std::stoi(file_name.substr(5, 2));
+		return month >= 1 && month <= 12
+			? year * 100 + month
+			: 0;
+	}
+	catch (const std::exception &)
+	{
+		return 0;
+	}
+}
@@ -0,0 +1,31 @@
+#include "lib/history/listeningstat.hpp"
+
+#include <algorithm>
+
+void lib::listening_stat::add(int track_duration, std::int64_t played_at)
+{
+	plays++;
+	duration += track_duration;
+	last_played = std::max(last_played, played_at);
+}
+
+void lib::to_json(nlohmann::json &j, const listening_stat &s)
+{
+	j = nlohmann::json::array({
+		s.id, s.name, s.plays, s.duration, s.last_played,
+	});
+}
+
+void lib::from_json(const nlohmann::json &j, listening_stat &s)
+{
+	if (!j.is_array() || j.size() < 5)
+	{
+		return;
+	}
+
+	j.at(0).get_to(s.id);
+	j.at(1).get_to(s.name);
+	j.at(2).get_to(s.plays);
+	j.at(3).get_to(s.duration);
+	j.at(4).get_to(s.last_played);
+}
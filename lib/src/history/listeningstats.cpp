@@ -0,0 +1,221 @@
+#include "lib/history/listeningstats.hpp"
+#include "lib/datetime.hpp"
+
+#include <algorithm>
+
+lib::listening_stats::listening_stats(std::int64_t utc_offset)
+	: utc_offset(utc_offset)
+{
+}
+
+void lib::listening_stats::add(const lib::spt::track &track, std::int64_t played_at)
+{
+	add(tracks, track.id, track.name, track.duration, played_at);
+
+	for (const auto &artist : track.artists)
+	{
+		add(artists, artist.id.empty() ? artist.name : artist.id,
+			artist.name, track.duration, played_at);
+	}
+
+	if (!track.album.name.empty())
+	{
+		add(albums, track.album.id.empty() ? track.album.name : track.album.id,
+			track.album.name, track.duration, played_at);
+	}
+
+	constexpr std::int64_t seconds_per_day = 24 * 60 * 60;
+	const auto local = played_at + utc_offset;
+
+	auto day = local / seconds_per_day;
+	auto time = local % seconds_per_day;
+	if (time < 0)
+	{
+		time += seconds_per_day;
+		day--;
+	}
+
+	hour_plays.at(static_cast<size_t>(time / 3600))++;
+
+	// 1970-01-01 was a Thursday
+	week_day_plays.at(static_cast<size_t>(((day + 3) % 7 + 7) % 7))++;
+
+	day_plays[day]++;
+
+	play_count++;
+	total_duration += track.duration;
+}
+
+auto lib::listening_stats::top_tracks(size_t count) const -> std::vector<lib::listening_stat>
+{
+	return top(tracks, count);
+}
+
+auto lib::listening_stats::top_artists(size_t count) const -> std::vector<lib::listening_stat>
+{
+	return top(artists, count);
+}
+
+auto lib::listening_stats::top_albums(size_t count) const -> std::vector<lib::listening_stat>
+{
+	return top(albums, count);
+}
+
+auto lib::listening_stats::hours() const -> const std::array<unsigned int, 24> &
+{
+	return hour_plays;
+}
+
+auto lib::listening_stats::week_days() const -> const std::array<unsigned int, 7> &
+{
+	return week_day_plays;
+}
+
+auto lib::listening_stats::days() const -> const std::map<std::int64_t, unsigned int> &
+{
+	return day_plays;
+}
+
+auto lib::listening_stats::plays() const -> size_t
+{
+	return play_count;
+}
+
+auto lib::listening_stats::duration() const -> long long
+{
+	return total_duration;
+}
+
+auto lib::listening_stats::get_utc_offset() const -> std::int64_t
+{
+	return utc_offset;
+}
+
+auto lib::listening_stats::local_utc_offset() -> std::int64_t
+{
+	constexpr std::int64_t quarter = 15 * 60;
+
+	const auto offset = lib::date_time::now().to_seconds_since_epoch()
+		- lib::date_time::now_utc().to_seconds_since_epoch();
+
+	// Both times are fetched separately, so may differ by a second
+	return (offset + (offset < 0 ? -quarter : quarter) / 2) / quarter * quarter;
+}
+
+void lib::listening_stats::add(stat_map &stats,
+	const std::string &id, const std::string &name, int duration, std::int64_t played_at)
+{
+	if (id.empty())
+	{
+		return;
+	}
+
+	auto &stat = stats[ids.intern(id)];
+	if (stat.id.empty())
+	{
+		stat.id = id;
+		stat.name = name;
+	}
+	stat.add(duration, played_at);
+}
+
+auto lib::listening_stats::top(const stat_map &stats, size_t count) -> std::vector<lib::listening_stat>
+{
+	std::vector<const lib::listening_stat *> sorted;
+	sorted.reserve(stats.size());
+	for (const auto &stat : stats)
+	{
+		sorted.push_back(&stat.second);
+	}
+
+	// Only sort as many as needed
+	const auto middle = sorted.begin()
+		+ static_cast<std::ptrdiff_t>(std::min(count, sorted.size()));
+
+	std::partial_sort(sorted.begin(), middle, sorted.end(),
+		[](const lib::listening_stat *stat1, const lib::listening_stat *stat2) -> bool
+		{
+			return stat1->plays != stat2->plays
+				? stat1->plays > stat2->plays
+				: stat1->last_played > stat2->last_played;
+		});
+
+	std::vector<lib::listening_stat> results;
+	results.reserve(static_cast<size_t>(middle - sorted.begin()));
+	for (auto iter = sorted.begin(); iter != middle; iter++)
+	{
+		results.push_back(**iter);
+	}
+	return results;
+}
+
+void lib::to_json(nlohmann::json &j, const listening_stats &s)
+{
+	const auto values = [](const listening_stats::stat_map &stats)
+		-> nlohmann::json
+	{
+		auto json = nlohmann::json::array();
+		for (const auto &stat : stats)
+		{
+			json.push_back(stat.second);
+		}
+		return json;
+	};
+
+	auto days = nlohmann::json::array();
+	for (const auto &day : s.day_plays)
+	{
+		days.push_back({day.first, day.second});
+	}
+
+	j = nlohmann::json{
+		{"utc_offset", s.utc_offset},
+		{"plays", s.play_count},
+		{"duration", s.total_duration},
+		{"tracks", values(s.tracks)},
+		{"artists", values(s.artists)},
+		{"albums", values(s.albums)},
+		{"hours", s.hour_plays},
+		{"week_days", s.week_day_plays},
+		{"days", days},
+	};
+}
+
+void lib::from_json(const nlohmann::json &j, listening_stats &s)
+{
+	if (!j.is_object())
+	{
+		return;
+	}
+
+	const auto values = [&j, &s](const std::string &key,
+		listening_stats::stat_map &stats)
+	{
+		if (!j.contains(key))
+		{
+			return;
+		}
+
+		for (const auto &item : j.at(key))
+		{
+			auto stat = item.get<listening_stat>();
+			stats[s.ids.intern(stat.id)] = stat;
+		}
+	};
+
+	j.at("utc_offset").get_to(s.utc_offset);
+	j.at("plays").get_to(s.play_count);
+	j.at("duration").get_to(s.total_duration);
+
+	values("tracks", s.tracks);
+	values("artists", s.artists);
+	values("albums", s.albums);
+
+	j.at("hours").get_to(s.hour_plays);
+	j.at("week_days").get_to(s.week_day_plays);
+
+	for (const auto &day : j.at("days"))
+	{
+		s.day_plays[day.at(0).get<std::int64_t>()] = day.at(1).get<unsigned int>();
+	}
+}
@@ -0,0 +1,46 @@
+#include "lib/internedstring.hpp"
+
+namespace
+{
+	const std::string empty_string;
+}
+
+lib::interned_string::interned_string()
+	: value(&empty_string)
+{
+}
+
+lib::interned_string::interned_string(const std::string *value)
+	: value(value)
+{
+}
+
+auto lib::interned_string::str() const -> const std::string &
+{
+	return *value;
+}
+
+lib::interned_string::operator const std::string &() const
+{
+	return *value;
+}
+
+auto lib::interned_string::empty() const -> bool
+{
+	return value->empty();
+}
+
+auto lib::interned_string::operator==(const interned_string &other) const -> bool
+{
+	return value == other.value;
+}
+
+auto lib::interned_string::operator!=(const interned_string &other) const -> bool
+{
+	return value != other.value;
+}
+
+auto lib::interned_string::operator<(const interned_string &other) const -> bool
+{
+	return *value < *other.value;
+}
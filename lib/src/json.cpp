@@ -1,5 +1,37 @@
 #include "lib/json.hpp"
 
+constexpr size_t lib::json::max_buffer_size;
+
+namespace
+{
+	/**
+	 * Frees buffer when leaving scope, even if parsing throws,
+	 * if it grew larger than allowed to be kept
+	 */
+	class buffer_guard
+	{
+	public:
+		buffer_guard(std::vector<char> &buffer, size_t max_size)
+			: buffer(buffer),
+			max_size(max_size)
+		{
+		}
+
+		~buffer_guard()
+		{
+			if (buffer.capacity() > max_size)
+			{
+				buffer.clear();
+				buffer.shrink_to_fit();
+			}
+		}
+
+	private:
+		std::vector<char> &buffer;
+		size_t max_size;
+	};
+}
+
 nlohmann::json lib::json::combine(const nlohmann::json &item1, const nlohmann::json &item2)
 {
 	auto item = nlohmann::json::array();
@@ -14,18 +46,10 @@ nlohmann::json lib::json::combine(const nlohmann::json &item1, const nlohmann::j
 
 nlohmann::json lib::json::load(const ghc::filesystem::path &path)
 {
-	std::ifstream file(path);
-	if (!file.is_open() || file.bad())
-	{
-		// File not found errors fail silently
-		return nlohmann::json();
-	}
-
 	try
 	{
-		nlohmann::json json;
-		file >> json;
-		return json;
+		// File not found errors fail silently
+		return parse_file(path);
 	}
 	catch (const std::exception &e)
 	{
@@ -36,6 +60,21 @@ nlohmann::json lib::json::load(const ghc::filesystem::path &path)
 	return nlohmann::json();
 }
 
+auto lib::json::parse_file(const ghc::filesystem::path &path) -> nlohmann::json
+{
+	// Reused between loads on the same thread, to avoid allocating for each file
+	thread_local std::vector<char> buffer;
+	const buffer_guard guard(buffer, max_buffer_size);
+
+	if (!read_file(path, buffer))
+	{
+		return nlohmann::json();
+	}
+
+	// Parsed from contiguous memory, instead of through the stream
+	return nlohmann::json::parse(buffer.data(), buffer.data() + buffer.size());
+}
+
 void lib::json::save(const ghc::filesystem::path &path, const nlohmann::json &json)
 {
 	try
@@ -0,0 +1,165 @@
+#include "lib/listdiff.hpp"
+
+#include <algorithm>
+
+lib::list_diff::list_diff(const std::vector<size_t> &previous, const std::vector<size_t> &next,
+	size_t max_changes)
+{
+	if (previous == next)
+	{
+		return;
+	}
+
+	size_t max_key = 0;
+	for (const auto &list : {&previous, &next})
+	{
+		if (!list->empty())
+		{
+			max_key = std::max(max_key, *std::max_element(list->begin(), list->end()));
+		}
+	}
+
+	// Index in next for each key, or size of next if not in next
+	std::vector<size_t> next_indices(max_key + 1, next.size());
+	for (size_t i = 0; i < next.size(); i++)
+	{
+		next_indices[next[i]] = i;
+	}
+
+	// Index in next for each kept item, in previous order
+	std::vector<size_t> kept;
+	std::vector<size_t> removed;
+	kept.reserve(previous.size());
+
+	for (size_t i = 0; i < previous.size(); i++)
+	{
+		const auto next_index = next_indices[previous[i]];
+		if (next_index == next.size())
+		{
+			removed.push_back(i);
+		}
+		else
+		{
+			kept.push_back(next_index);
+		}
+	}
+
+	// Kept items already in order never have to move
+	const auto in_order = longest_increasing(kept);
+	const auto in_order_count = static_cast<size_t>(std::count(in_order.begin(),
+		in_order.end(), true));
+
+	const auto change_count = removed.size()
+		+ (next.size() - kept.size())
+		+ (kept.size() - in_order_count);
+
+	if (change_count > max_changes)
+	{
+		exceeded = true;
+		return;
+	}
+	items.reserve(change_count);
+
+	// Last first, so earlier indices stay the same
+	for (auto iter = removed.crbegin(); iter != removed.crend(); iter++)
+	{
+		items.push_back({change_type::remove, *iter, *iter});
+	}
+
+	std::vector<bool> is_kept(next.size(), false);
+	std::vector<bool> stays(next.size(), false);
+	for (size_t i = 0; i < kept.size(); i++)
+	{
+		is_kept[kept[i]] = true;
+		stays[kept[i]] = in_order[i];
+	}
+
+	// From last, placing each item before the one after it
+	auto current = kept;
+	for (auto i = next.size(); i-- > 0;)
+	{
+		if (stays[i])
+		{
+			continue;
+		}
+
+		const auto anchor = i + 1 < next.size()
+			? static_cast<size_t>(std::find(current.begin(), current.end(), i + 1)
+				- current.begin())
+			: current.size();
+
+		if (!is_kept[i])
+		{
+			items.push_back({change_type::insert, i, anchor});
+			current.insert(current.begin() + static_cast<long>(anchor), i);
+			continue;
+		}
+
+		const auto from = static_cast<size_t>(std::find(current.begin(), current.end(), i)
+			- current.begin());
+		if (from == anchor || from + 1 == anchor)
+		{
+			continue;
+		}
+
+		items.push_back({change_type::move, from, anchor});
+		current.erase(current.begin() + static_cast<long>(from));
+		current.insert(current.begin() + static_cast<long>(from < anchor ? anchor - 1 : anchor), i);
+	}
+}
+
+auto lib::list_diff::changes() const -> const std::vector<change> &
+{
+	return items;
+}
+
+auto lib::list_diff::empty() const -> bool
+{
+	return items.empty() && !exceeded;
+}
+
+auto lib::list_diff::exceeds_limit() const -> bool
+{
+	return exceeded;
+}
+
+auto lib::list_diff::longest_increasing(const std::vector<size_t> &values) -> std::vector<bool>
+{
+	// Index of last value, for the lowest last value of each length
+	std::vector<size_t> tails;
+	// Index of value before, for each value in a sequence
+	std::vector<size_t> before(values.size(), values.size());
+
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		const auto tail = std::lower_bound(tails.begin(), tails.end(), values[i],
+			[&values](size_t index, size_t value) -> bool
+			{
+				return values[index] < value;
+			});
+
+		if (tail != tails.begin())
+		{
+			before[i] = *(tail - 1);
+		}
+
+		if (tail == tails.end())
+		{
+			tails.push_back(i);
+		}
+		else
+		{
+			*tail = i;
+		}
+	}
+
+	std::vector<bool> result(values.size(), false);
+	if (!tails.empty())
+	{
+		for (auto i = tails.back(); i < values.size(); i = before[i])
+		{
+			result[i] = true;
+		}
+	}
+	return result;
+}
@@ -6,9 +6,14 @@ std::vector<log_message> log::messages = std::vector<log_message>();
 
 bool log::log_to_stdout = true;
 
+std::mutex log::mutex;
+
 void log::message(log_type log_type, const std::string &message)
 {
 	log_message msg(log_type, message);
+
+	// Messages can be logged from background threads
+	std::lock_guard<std::mutex> lock(mutex);
 	messages.push_back(msg);
 
 	if (!log_to_stdout)
@@ -27,6 +32,7 @@ const std::vector<log_message> &log::get_messages()
 
 void log::clear()
 {
+	std::lock_guard<std::mutex> lock(mutex);
 	messages.clear();
 }
 
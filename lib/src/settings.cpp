@@ -1,4 +1,5 @@
 #include "lib/settings.hpp"
+#include "lib/json.hpp"
 
 using namespace lib;
 
@@ -63,12 +64,14 @@ void settings::from_json(const nlohmann::json &json)
 	setValue(a, "refresh_token", account.refresh_token);
 
 	// General
+	setValue(g, "album_cache_size", general.album_cache_size);
 	setValue(g, "custom_playlist_order", general.custom_playlist_order);
 	setValue(g, "fallback_icons", general.fallback_icons);
 	setValue(g, "fixed_width_time", general.fixed_width_time);
 	setValue(g, "hidden_song_headers", general.hidden_song_headers);
 	setValue(g, "last_device", general.last_device);
 	setValue(g, "last_playlist", general.last_playlist);
+	setValue(g, "last_saved_tracks_sync", general.last_saved_tracks_sync);
 	setValue(g, "last_version", general.last_version);
 	setValue(g, "last_volume", general.last_volume);
 	setValue(g, "media_controller", general.media_controller);
@@ -125,25 +128,20 @@ void settings::load()
 {
 	auto name = file_name();
 
-	std::ifstream file(name);
-	if (!file.is_open())
-	{
-		log::warn("Failed to load settings: \"{}\" not found", name);
-		return;
-	}
-
 	try
 	{
-		nlohmann::json json;
-		file >> json;
+		auto json = lib::json::parse_file(name);
+		if (json.is_null())
+		{
+			log::warn("Failed to load settings: \"{}\" not found", name);
+			return;
+		}
 		from_json(json);
 	}
 	catch (const nlohmann::json::exception &e)
 	{
 		log::error("Failed to load settings: {}", e.what());
 	}
-
-	file.close();
 }
 
 auto settings::to_json() const -> nlohmann::json
@@ -157,12 +155,14 @@ auto settings::to_json() const -> nlohmann::json
 			{"refresh_token", account.refresh_token},
 		}},
 		{"General", {
+			{"album_cache_size", general.album_cache_size},
 			{"custom_playlist_order", general.custom_playlist_order},
 			{"fallback_icons", general.fallback_icons},
 			{"fixed_width_time", general.fixed_width_time},
 			{"hidden_song_headers", general.hidden_song_headers},
 			{"last_device", general.last_device},
 			{"last_playlist", general.last_playlist},
+			{"last_saved_tracks_sync", general.last_saved_tracks_sync},
 			{"last_version", general.last_version},
 			{"last_volume", general.last_volume},
 			{"media_controller", general.media_controller},
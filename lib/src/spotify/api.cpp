@@ -159,6 +159,13 @@ auto api::to_uri(const std::string &type, const std::string &id) -> std::string
 		: lib::fmt::format("spotify:{}:{}", type, id);
 }
 
+auto api::to_uri(const std::string &type, const lib::spt::id &id) -> std::string
+{
+	return id.is_valid()
+		? lib::fmt::format("spotify:{}:{}", type, id.to_string())
+		: std::string();
+}
+
 auto api::to_id(const std::string &id) -> std::string
 {
 	auto i = lib::strings::last_index_of(id, ":");
@@ -167,11 +174,25 @@ auto api::to_id(const std::string &id) -> std::string
 		: id;
 }
 
+auto api::to_packed_id(const std::string &id) -> lib::spt::id
+{
+	return lib::spt::id(to_id(id));
+}
+
 auto api::to_full_url(const std::string &relative_url) -> std::string
 {
 	return lib::fmt::format("https://api.spotify.com/v1/{}", relative_url);
 }
 
+auto api::to_relative_url(const std::string &url) -> std::string
+{
+	constexpr size_t api_prefix_length = 27;
+
+	return lib::strings::starts_with(url, "https://api.spotify.com/v1/")
+		? url.substr(api_prefix_length)
+		: url;
+}
+
 auto api::follow_type_string(lib::follow_type type) -> std::string
 {
 	switch (type)
@@ -218,38 +239,124 @@ void api::get(const std::string &url, lib::callback<nlohmann::json> &callback)
 }
 
 void api::get_items(const std::string &url, const std::string &key,
-	lib::callback<nlohmann::json> &callback)
+	lib::move_callback<nlohmann::json> &callback)
 {
-	constexpr size_t api_prefix_length = 27;
+	get_items_page(url, key, std::make_shared<nlohmann::json>(nlohmann::json::array()),
+		callback);
+}
 
-	auto api_url = lib::strings::starts_with(url, "https://api.spotify.com/v1/")
-		? url.substr(api_prefix_length)
-		: url;
+void api::get_items(const std::string &url, lib::move_callback<nlohmann::json> &callback)
+{
+	get_items(url, std::string(), callback);
+}
 
-	get(api_url, [this, key, callback](const nlohmann::json &json)
-	{
-		if (!key.empty() && !json.contains(key))
-		{
-			lib::log::error(R"(no such key "{}" in "{}" ({}))", key, json.dump());
-		}
+void api::get_items_page(const std::string &url, const std::string &key,
+	const std::shared_ptr<nlohmann::json> &items,
+	lib::move_callback<nlohmann::json> &callback)
+{
+	const auto relative_url = to_relative_url(url);
 
-		const auto &items = (key.empty() ? json : json.at(key)).at("items");
-		if (json.contains("next") && json.at("next").is_string())
+	// Parsed here instead of using get, so items can be moved out of each page
+	http.get(to_full_url(relative_url), auth_headers(),
+		[this, relative_url, key, items, callback](const std::string &response)
 		{
-			const auto &next = json.at("next").get<std::string>();
-			get_items(next, key, [items, callback](const nlohmann::json &next)
+			try
 			{
-				callback(lib::json::combine(items, next));
-			});
-			return;
-		}
-		callback(items);
-	});
+				auto json = response.empty()
+					? nlohmann::json()
+					: nlohmann::json::parse(response);
+
+				if (!key.empty() && !json.contains(key))
+				{
+					lib::log::error(R"(no such key "{}" in "{}" ({}))", key, json.dump());
+				}
+
+				auto &page = key.empty() ? json : json.at(key);
+				auto &page_items = page.at("items");
+
+				if (items->empty() && page.contains("total") && page.at("total").is_number())
+				{
+					items->get_ref<nlohmann::json::array_t &>()
+						.reserve(page.at("total").get<size_t>());
+				}
+
+				for (auto &item : page_items)
+				{
+					items->push_back(std::move(item));
+				}
+
+				if (json.contains("next") && json.at("next").is_string())
+				{
+					get_items_page(json.at("next").get<std::string>(), key, items, callback);
+					return;
+				}
+
+				callback(std::move(*items));
+			}
+			catch (const std::exception &e)
+			{
+				lib::log::error("{} failed: {}", relative_url, e.what());
+			}
+		});
 }
 
-void api::get_items(const std::string &url, lib::callback<nlohmann::json> &callback)
+void api::get_track_items(const std::string &url,
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
 {
-	get_items(url, std::string(), callback);
+	get_track_items_page(url, std::make_shared<std::vector<lib::spt::track>>(), callback);
+}
+
+void api::get_track_items_page(const std::string &url,
+	const std::shared_ptr<std::vector<lib::spt::track>> &tracks,
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
+{
+	const auto relative_url = to_relative_url(url);
+
+	http.get(to_full_url(relative_url), auth_headers(),
+		[this, relative_url, tracks, callback](const std::string &response)
+		{
+			try
+			{
+				std::string next;
+
+				// Page only lives until its tracks are converted
+				{
+					lib::arena arena(response.size() * 2);
+					lib::arena::scope scope(arena);
+
+					const auto json = response.empty()
+						? lib::arena_json()
+						: lib::arena_json::parse(response);
+
+					if (tracks->empty() && json.contains("total") && json.at("total").is_number())
+					{
+						tracks->reserve(json.at("total").get<size_t>());
+					}
+
+					for (const auto &item : json.at("items"))
+					{
+						tracks->push_back(item.get<lib::spt::track>());
+					}
+
+					if (json.contains("next") && json.at("next").is_string())
+					{
+						next = json.at("next").get<std::string>();
+					}
+				}
+
+				if (!next.empty())
+				{
+					get_track_items_page(next, tracks, callback);
+					return;
+				}
+
+				callback(std::move(*tracks));
+			}
+			catch (const std::exception &e)
+			{
+				lib::log::error("{} failed: {}", relative_url, e.what());
+			}
+		});
 }
 
 //endregion
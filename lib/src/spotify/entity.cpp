@@ -8,7 +8,8 @@ void lib::spt::to_json(nlohmann::json &j, const entity &e)
 	};
 }
 
-void lib::spt::from_json(const nlohmann::json &j, entity &e)
+template<typename Json>
+void entity_from_json(const Json &j, lib::spt::entity &e)
 {
 	if (!j.is_object())
 	{
@@ -34,6 +35,16 @@ void lib::spt::from_json(const nlohmann::json &j, entity &e)
 	}
 }
 
+void lib::spt::from_json(const nlohmann::json &j, entity &e)
+{
+	entity_from_json(j, e);
+}
+
+void lib::spt::from_json(const lib::arena_json &j, entity &e)
+{
+	entity_from_json(j, e);
+}
+
 auto lib::spt::entity::combine_names(const std::vector<entity> &entities,
 	const char *separator) -> std::string
 {
@@ -0,0 +1,132 @@
+#include "lib/spotify/id.hpp"
+
+constexpr size_t lib::spt::id::length;
+
+namespace
+{
+	constexpr const char *base62 = "0123456789"
+		"abcdefghijklmnopqrstuvwxyz"
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+	constexpr std::uint64_t base = 62;
+	constexpr std::uint64_t mask = 0xffffffffULL;
+}
+
+lib::spt::id::id(const std::string &value)
+{
+	if (value.size() != length)
+	{
+		return;
+	}
+
+	// 32-bit parts, most significant first, so 64-bit math never overflows
+	std::uint64_t parts[4] = {0, 0, 0, 0};
+
+	for (const auto c : value)
+	{
+		const auto value_digit = digit(c);
+		if (value_digit < 0)
+		{
+			return;
+		}
+
+		auto carry = static_cast<std::uint64_t>(value_digit);
+		for (auto i = 3; i >= 0; i--)
+		{
+			const auto result = parts[i] * base + carry;
+			parts[i] = result & mask;
+			carry = result >> 32U;
+		}
+
+		// Larger than 128 bits
+		if (carry != 0)
+		{
+			return;
+		}
+	}
+
+	const auto parsed_high = (parts[0] << 32U) | parts[1];
+	const auto parsed_low = (parts[2] << 32U) | parts[3];
+
+	// Reserved for invalid
+	if (parsed_high == ~0ULL && parsed_low == ~0ULL)
+	{
+		return;
+	}
+
+	high = parsed_high;
+	low = parsed_low;
+}
+
+auto lib::spt::id::is_valid() const -> bool
+{
+	return high != ~0ULL || low != ~0ULL;
+}
+
+auto lib::spt::id::to_string() const -> std::string
+{
+	if (!is_valid())
+	{
+		return std::string();
+	}
+
+	std::uint64_t parts[4] = {
+		high >> 32U, high & mask,
+		low >> 32U, low & mask,
+	};
+
+	std::string value(length, '0');
+	for (auto index = length; index > 0; index--)
+	{
+		std::uint64_t remainder = 0;
+		for (auto &part : parts)
+		{
+			const auto current = (remainder << 32U) | part;
+			part = current / base;
+			remainder = current % base;
+		}
+		value[index - 1] = base62[remainder];
+	}
+
+	return value;
+}
+
+auto lib::spt::id::operator==(const id &other) const -> bool
+{
+	return high == other.high && low == other.low;
+}
+
+auto lib::spt::id::operator!=(const id &other) const -> bool
+{
+	return !(*this == other);
+}
+
+auto lib::spt::id::operator<(const id &other) const -> bool
+{
+	return high != other.high
+		? high < other.high
+		: low < other.low;
+}
+
+auto lib::spt::id::hash() const -> size_t
+{
+	// IDs are random, so mixing both halves is enough
+	return static_cast<size_t>(low ^ (high * 0x9e3779b97f4a7c15ULL));
+}
+
+auto lib::spt::id::digit(char c) -> int
+{
+	if (c >= '0' && c <= '9')
+	{
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'z')
+	{
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'Z')
+	{
+		return c - 'A' + 36;
+	}
+	return -1;
+}
@@ -0,0 +1,101 @@
+#include "lib/spotify/playlistdelta.hpp"
+
+#include <algorithm>
+
+constexpr int lib::spt::playlist_delta::page_size;
+constexpr int lib::spt::playlist_delta::sample_count;
+
+lib::spt::playlist_delta::playlist_delta(const lib::spt::playlist &cached,
+	const lib::spt::playlist &latest)
+	: cached_total(static_cast<int>(cached.tracks.size())),
+	latest_total(latest.tracks_total)
+{
+	if (cached.is_null() || cached.tracks.empty())
+	{
+		return;
+	}
+
+	up_to_date = latest.is_up_to_date(cached.snapshot);
+	last_id = cached.tracks.back().id;
+}
+
+auto lib::spt::playlist_delta::is_up_to_date() const -> bool
+{
+	return up_to_date;
+}
+
+auto lib::spt::playlist_delta::is_append() const -> bool
+{
+	return !up_to_date
+		&& cached_total > 0
+		&& latest_total > cached_total
+		&& !last_id.empty();
+}
+
+auto lib::spt::playlist_delta::offset() const -> int
+{
+	return cached_total - 1;
+}
+
+auto lib::spt::playlist_delta::checks() const -> std::vector<std::pair<int, int>>
+{
+	std::vector<std::pair<int, int>> results;
+	if (!is_append())
+	{
+		return results;
+	}
+
+	// Last cached track is already checked when fetching from offset
+	const auto last = offset();
+	const auto first_page = std::min(page_size, last);
+	if (first_page > 0)
+	{
+		results.emplace_back(0, first_page);
+	}
+
+	const auto rest = last - first_page;
+	for (auto i = 1; i <= sample_count && rest > 0; i++)
+	{
+		const auto index = first_page + rest * i / (sample_count + 1);
+		if (results.empty() || index >= results.back().first + results.back().second)
+		{
+			results.emplace_back(index, 1);
+		}
+	}
+
+	return results;
+}
+
+auto lib::spt::playlist_delta::apply(const std::vector<lib::spt::track> &checked,
+	const std::vector<lib::spt::track> &fetched,
+	std::vector<lib::spt::track> &tracks) const -> bool
+{
+	if (!is_append()
+		|| static_cast<int>(tracks.size()) != cached_total
+		|| static_cast<int>(fetched.size()) != latest_total - offset()
+		|| fetched.front().id != last_id)
+	{
+		return false;
+	}
+
+	size_t checked_index = 0;
+	for (const auto &check : checks())
+	{
+		for (auto index = check.first; index < check.first + check.second; index++)
+		{
+			if (checked_index >= checked.size()
+				|| checked.at(checked_index++).id != tracks.at(static_cast<size_t>(index)).id)
+			{
+				return false;
+			}
+		}
+	}
+
+	if (checked_index != checked.size())
+	{
+		return false;
+	}
+
+	tracks.insert(tracks.end(), fetched.begin() + 1, fetched.end());
+	return true;
+}
@@ -0,0 +1,106 @@
+#include "lib/spotify/savedtracksdelta.hpp"
+
+lib::spt::saved_tracks_delta::saved_tracks_delta(const std::vector<lib::spt::track> &cached)
+{
+	for (const auto &track : cached)
+	{
+		// ISO dates can be compared as strings
+		if (track.added_at > watermark)
+		{
+			watermark = track.added_at;
+			watermark_ids.clear();
+		}
+		if (track.added_at == watermark)
+		{
+			watermark_ids.insert(track.id);
+		}
+	}
+}
+
+auto lib::spt::saved_tracks_delta::add(const std::vector<lib::spt::track> &page) -> bool
+{
+	if (done)
+	{
+		return false;
+	}
+
+	for (const auto &track : page)
+	{
+		if (!watermark.empty()
+			&& (track.added_at < watermark
+				|| (track.added_at == watermark
+					&& watermark_ids.contains(track.id))))
+		{
+			done = true;
+			return false;
+		}
+
+		new_tracks.push_back(track);
+	}
+
+	return !page.empty();
+}
+
+auto lib::spt::saved_tracks_delta::apply(int total,
+	std::vector<lib::spt::track> &tracks) const -> bool
+{
+	id_set added_ids;
+	for (const auto &track : new_tracks)
+	{
+		added_ids.insert(track.id);
+	}
+
+	std::vector<lib::spt::track> merged;
+	merged.reserve(new_tracks.size() + tracks.size());
+	merged.insert(merged.end(), new_tracks.begin(), new_tracks.end());
+
+	// Tracks saved again are moved to the top
+	for (const auto &track : tracks)
+	{
+		if (!added_ids.contains(track.id))
+		{
+			merged.push_back(track);
+		}
+	}
+
+	// Tracks were removed since cached
+	if (total < 0 || static_cast<size_t>(total) != merged.size())
+	{
+		return false;
+	}
+
+	tracks = std::move(merged);
+	return true;
+}
+
+auto lib::spt::saved_tracks_delta::added() const -> const std::vector<lib::spt::track> &
+{
+	return new_tracks;
+}
+
+void lib::spt::saved_tracks_delta::id_set::insert(const std::string &id)
+{
+	const lib::spt::id packed(id);
+	if (packed.is_valid())
+	{
+		ids.insert(packed);
+	}
+	else
+	{
+		other_ids.insert(id);
+	}
+}
+
+auto lib::spt::saved_tracks_delta::id_set::contains(const std::string &id) const -> bool
+{
+	const lib::spt::id packed(id);
+	return packed.is_valid()
+		? ids.find(packed) != ids.end()
+		: other_ids.find(id) != other_ids.end();
+}
+
+void lib::spt::saved_tracks_delta::id_set::clear()
+{
+	ids.clear();
+	other_ids.clear();
+}
@@ -18,7 +18,8 @@ void lib::spt::to_json(nlohmann::json &j, const track &t)
 	};
 }
 
-void from_cache(const nlohmann::json &j, lib::spt::track &t)
+template<typename Json>
+void from_cache(const Json &j, lib::spt::track &t)
 {
 	if (!j.is_object())
 	{
@@ -69,7 +70,8 @@ void from_cache(const nlohmann::json &j, lib::spt::track &t)
 	t.artists.shrink_to_fit();
 }
 
-void lib::spt::from_json(const nlohmann::json &j, track &t)
+template<typename Json>
+void track_from_json(const Json &j, lib::spt::track &t)
 {
 	if (!j.is_object())
 	{
@@ -84,7 +86,7 @@ void lib::spt::from_json(const nlohmann::json &j, track &t)
 	}
 
 	// Object that contains the actual track object
-	auto track = j.contains("track")
+	const auto &track = j.contains("track")
 		? j.at("track")
 		: j;
 
@@ -102,7 +104,7 @@ void lib::spt::from_json(const nlohmann::json &j, track &t)
 
 	if (track.contains("album"))
 	{
-		auto album = track.at("album");
+		const auto &album = track.at("album");
 		album.get_to(t.album);
 
 		if (album.contains("images"))
@@ -129,6 +131,16 @@ void lib::spt::from_json(const nlohmann::json &j, track &t)
 		t.added_at = std::string();
 }
 
+void lib::spt::from_json(const nlohmann::json &j, track &t)
+{
+	track_from_json(j, t);
+}
+
+void lib::spt::from_json(const lib::arena_json &j, track &t)
+{
+	track_from_json(j, t);
+}
+
 auto lib::spt::track::title() const -> std::string
 {
 	return is_valid()
@@ -8,19 +8,16 @@ void api::album(const std::string &id, lib::callback<lib::spt::album> &callback)
 }
 
 void api::album_tracks(const lib::spt::album &album,
-	lib::callback<std::vector<lib::spt::track>> &callback)
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
 {
-	get_items(lib::fmt::format("albums/{}/tracks?limit=50", album.id),
-		[album, callback](const std::vector<lib::spt::track> &results)
+	const auto &album_name = album.name;
+	get_track_items(lib::fmt::format("albums/{}/tracks?limit=50", album.id),
+		[album_name, callback](std::vector<lib::spt::track> &&tracks)
 		{
-			std::vector<lib::spt::track> tracks;
-			tracks.reserve(results.size());
-			for (const auto &result : results)
+			for (auto &track : tracks)
 			{
-				lib::spt::track track = result;
-				track.album.name = album.name;
-				tracks.push_back(track);
+				track.album.name = album_name;
 			}
-			callback(tracks);
+			callback(std::move(tracks));
 		});
 }
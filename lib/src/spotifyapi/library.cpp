@@ -12,9 +12,24 @@ void api::saved_albums(lib::callback<std::vector<lib::spt::saved_album>> &callba
 	get_items("me/albums", callback);
 }
 
-void api::saved_tracks(lib::callback<std::vector<lib::spt::track>> &callback)
+void api::saved_tracks(lib::move_callback<std::vector<lib::spt::track>> &callback)
 {
-	get_items("me/tracks?limit=50", callback);
+	get_track_items("me/tracks?limit=50", callback);
+}
+
+void api::saved_tracks(const std::vector<lib::spt::track> &cached,
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
+{
+	if (cached.empty())
+	{
+		saved_tracks(callback);
+		return;
+	}
+
+	// Shared between pages, instead of copied into each continuation
+	saved_tracks_page("me/tracks?limit=50",
+		std::make_shared<const std::vector<lib::spt::track>>(cached),
+		std::make_shared<lib::spt::saved_tracks_delta>(cached), callback);
 }
 
 void api::add_saved_track(const std::string &track_id,
@@ -37,6 +52,43 @@ void api::remove_saved_track(const std::string &track_id,
 	}, callback);
 }
 
+void api::saved_tracks_page(const std::string &url,
+	const std::shared_ptr<const std::vector<lib::spt::track>> &cached,
+	const std::shared_ptr<lib::spt::saved_tracks_delta> &delta,
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
+{
+	get(url, [this, cached, delta, callback](const nlohmann::json &json)
+	{
+		if (!json.is_object() || !json.contains("items"))
+		{
+			saved_tracks(callback);
+			return;
+		}
+
+		const auto more = delta->add(json.at("items")
+			.get<std::vector<lib::spt::track>>());
+
+		if (more && json.contains("next") && json.at("next").is_string())
+		{
+			saved_tracks_page(to_relative_url(json.at("next").get<std::string>()),
+				cached, delta, callback);
+			return;
+		}
+
+		auto tracks = *cached;
+		if (json.contains("total") && json.at("total").is_number_integer()
+			&& delta->apply(json.at("total").get<int>(), tracks))
+		{
+			lib::log::dev("Fetched {} new saved tracks", delta->added().size());
+			callback(std::move(tracks));
+			return;
+		}
+
+		// Tracks were also removed, or total is unknown, fetch everything
+		saved_tracks(callback);
+	});
+}
+
 void api::is_saved_track(const std::vector<std::string> &track_ids,
 	lib::callback<std::vector<bool>> &callback)
 {
@@ -9,5 +9,5 @@ void api::top_artists(lib::callback<std::vector<lib::spt::artist>> &callback)
 
 void api::top_tracks(lib::callback<std::vector<lib::spt::track>> &callback)
 {
-	get_items("me/top/tracks?limit=50", callback);
+	get_track_items("me/top/tracks?limit=50", callback);
 }
@@ -171,7 +171,14 @@ void api::set_shuffle(bool enabled, lib::callback<std::string> &callback)
 
 void api::recently_played(lib::callback<std::vector<lib::spt::track>> &callback)
 {
-	get_items("me/player/recently-played?limit=50", callback);
+	get_track_items("me/player/recently-played?limit=50", callback);
+}
+
+void api::recently_played(long long after,
+	lib::callback<std::vector<lib::spt::track>> &callback)
+{
+	get_track_items(lib::fmt::format("me/player/recently-played?limit=50&after={}", after),
+		callback);
 }
 
 void api::add_to_queue(const std::string &uri, lib::callback<std::string> &callback)
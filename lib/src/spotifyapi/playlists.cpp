@@ -29,14 +29,24 @@ void api::edit_playlist(const std::string &playlist_id,
 }
 
 void api::playlist_tracks(const lib::spt::playlist &playlist,
-	lib::callback<std::vector<lib::spt::track>> &callback)
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
 {
-	auto fetch = [this, callback](const std::string &url)
+	playlist_tracks(playlist, 0, callback);
+}
+
+void api::playlist_tracks(const lib::spt::playlist &playlist, int offset,
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
+{
+	auto fetch = [this, offset, callback](const std::string &url)
 	{
 		auto item_url = lib::strings::contains(url, "market=")
 			? url : lib::fmt::format("{}{}market=from_token",
 				url, lib::strings::contains(url, "?") ? "&" : "?");
-		get_items(item_url, callback);
+		if (offset > 0)
+		{
+			item_url = lib::fmt::format("{}&offset={}", item_url, offset);
+		}
+		get_track_items(item_url, callback);
 	};
 
 	if (playlist.tracks_href.empty())
@@ -52,6 +62,80 @@ void api::playlist_tracks(const lib::spt::playlist &playlist,
 	}
 }
 
+void api::playlist_tracks(const lib::spt::playlist &cached,
+	const lib::spt::playlist &latest,
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
+{
+	const lib::spt::playlist_delta delta(cached, latest);
+
+	if (delta.is_up_to_date())
+	{
+		callback(std::vector<lib::spt::track>(cached.tracks));
+		return;
+	}
+
+	if (!delta.is_append() || latest.tracks_href.empty())
+	{
+		playlist_tracks(latest, callback);
+		return;
+	}
+
+	// Shared, as the continuation is copied along with the callback
+	const auto tracks = std::make_shared<const std::vector<lib::spt::track>>(cached.tracks);
+	const auto checks = std::make_shared<const std::vector<std::pair<int, int>>>(delta.checks());
+
+	playlist_checks(latest, checks, 0, std::make_shared<std::vector<lib::spt::track>>(),
+		[this, delta, tracks, latest, callback](std::vector<lib::spt::track> &&checked)
+		{
+			const auto checked_tracks = std::make_shared<const std::vector<lib::spt::track>>(
+				std::move(checked));
+
+			playlist_tracks(latest, delta.offset(),
+				[this, delta, tracks, checked_tracks, latest, callback]
+					(std::vector<lib::spt::track> &&fetched)
+				{
+					auto merged = *tracks;
+					if (delta.apply(*checked_tracks, fetched, merged))
+					{
+						lib::log::dev("Fetched {} new tracks in {}",
+							fetched.size() - 1, latest.id);
+						callback(std::move(merged));
+						return;
+					}
+
+					// Something else changed, fetch everything
+					playlist_tracks(latest, callback);
+				});
+		});
+}
+
+void api::playlist_checks(const lib::spt::playlist &playlist,
+	const std::shared_ptr<const std::vector<std::pair<int, int>>> &checks, size_t index,
+	const std::shared_ptr<std::vector<lib::spt::track>> &checked,
+	lib::move_callback<std::vector<lib::spt::track>> &callback)
+{
+	if (index >= checks->size())
+	{
+		callback(std::move(*checked));
+		return;
+	}
+
+	const auto &check = checks->at(index);
+	const auto url = to_relative_url(playlist.tracks_href);
+
+	get(lib::fmt::format("{}{}market=from_token&offset={}&limit={}",
+			url, lib::strings::contains(url, "?") ? "&" : "?",
+			check.first, check.second),
+		[this, playlist, checks, index, checked, callback](const nlohmann::json &json)
+		{
+			for (const auto &item : json.at("items"))
+			{
+				checked->push_back(item.get<lib::spt::track>());
+			}
+			playlist_checks(playlist, checks, index + 1, checked, callback);
+		});
+}
+
 void api::add_to_playlist(const std::string &playlist_id, const std::string &track_id,
 	lib::callback<std::string> &callback)
 {
@@ -0,0 +1,54 @@
+#include "lib/stringpool.hpp"
+
+lib::string_pool::string_pool(string_pool &&other) noexcept
+{
+	std::lock_guard<std::mutex> lock(other.mutex);
+	strings = std::move(other.strings);
+	string_bytes = other.string_bytes;
+	other.string_bytes = 0;
+}
+
+auto lib::string_pool::operator=(string_pool &&other) noexcept -> string_pool &
+{
+	if (this != &other)
+	{
+		std::lock(mutex, other.mutex);
+		std::lock_guard<std::mutex> lock(mutex, std::adopt_lock);
+		std::lock_guard<std::mutex> other_lock(other.mutex, std::adopt_lock);
+
+		strings = std::move(other.strings);
+		string_bytes = other.string_bytes;
+		other.string_bytes = 0;
+	}
+	return *this;
+}
+
+auto lib::string_pool::intern(const std::string &value) -> lib::interned_string
+{
+	// All empty strings are the same
+	if (value.empty())
+	{
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	const auto result = strings.insert(value);
+	if (result.second)
+	{
+		string_bytes += value.size();
+	}
+	return lib::interned_string(&*result.first);
+}
+
+auto lib::string_pool::size() const -> size_t
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return strings.size();
+}
+
+auto lib::string_pool::bytes() const -> size_t
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return string_bytes;
+}
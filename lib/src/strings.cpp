@@ -144,6 +144,212 @@ auto strings::to_lower(const std::string &str) -> std::string
 	return val;
 }
 
+auto strings::fold_case(const std::string &str) -> std::string
+{
+	std::string val;
+	val.reserve(str.size());
+
+	size_t i = 0;
+	while (i < str.size())
+	{
+		const auto chr = static_cast<unsigned char>(str[i]);
+		if (chr < 0x80)
+		{
+			val += static_cast<char>(chr >= 'A' && chr <= 'Z' ? chr + 0x20 : chr);
+			i++;
+			continue;
+		}
+
+		size_t length = 0;
+		auto code = static_cast<char32_t>(0);
+		if ((chr & 0xe0) == 0xc0)
+		{
+			length = 2;
+			code = chr & 0x1f;
+		}
+		else if ((chr & 0xf0) == 0xe0)
+		{
+			length = 3;
+			code = chr & 0x0f;
+		}
+		else if ((chr & 0xf8) == 0xf0)
+		{
+			length = 4;
+			code = chr & 0x07;
+		}
+
+		auto valid = length > 0 && i + length <= str.size();
+		for (size_t j = 1; valid && j < length; j++)
+		{
+			const auto next = static_cast<unsigned char>(str[i + j]);
+			valid = (next & 0xc0) == 0x80;
+			code = (code << 6) | (next & 0x3f);
+		}
+
+		if (!valid)
+		{
+			val += str[i];
+			i++;
+			continue;
+		}
+
+		const auto folded = fold_code_point(code);
+		if (folded == code)
+		{
+			val.append(str, i, length);
+		}
+		else
+		{
+			append_utf8(val, folded);
+		}
+		i += length;
+	}
+
+	return val;
+}
+
+auto strings::fold_code_point(char32_t code) -> char32_t
+{
+	// Latin-1 Supplement
+	if (code == 0xb5)
+	{
+		return 0x3bc;
+	}
+	if (code >= 0xc0 && code <= 0xde && code != 0xd7)
+	{
+		return code + 0x20;
+	}
+
+	// Latin Extended-A
+	if ((code >= 0x100 && code <= 0x12f)
+		|| (code >= 0x132 && code <= 0x137)
+		|| (code >= 0x14a && code <= 0x177))
+	{
+		return code | 1U;
+	}
+	if ((code >= 0x139 && code <= 0x148)
+		|| (code >= 0x179 && code <= 0x17e))
+	{
+		return code % 2 == 1 ? code + 1 : code;
+	}
+	if (code == 0x178)
+	{
+		return 0xff;
+	}
+	if (code == 0x17f)
+	{
+		return 's';
+	}
+
+	// Latin Extended-B, only the regular pairs
+	if ((code >= 0x200 && code <= 0x21f)
+		|| (code >= 0x222 && code <= 0x233))
+	{
+		return code | 1U;
+	}
+
+	// Greek
+	if (code == 0x386)
+	{
+		return 0x3ac;
+	}
+	if (code >= 0x388 && code <= 0x38a)
+	{
+		return code + 37;
+	}
+	if (code == 0x38c)
+	{
+		return 0x3cc;
+	}
+	if (code >= 0x38e && code <= 0x38f)
+	{
+		return code + 63;
+	}
+	if (code >= 0x391 && code <= 0x3ab && code != 0x3a2)
+	{
+		return code + 0x20;
+	}
+	if (code == 0x3c2)
+	{
+		return 0x3c3;
+	}
+
+	// Cyrillic
+	if (code >= 0x400 && code <= 0x40f)
+	{
+		return code + 0x50;
+	}
+	if (code >= 0x410 && code <= 0x42f)
+	{
+		return code + 0x20;
+	}
+	if ((code >= 0x460 && code <= 0x481)
+		|| (code >= 0x48a && code <= 0x4bf)
+		|| (code >= 0x4d0 && code <= 0x52f))
+	{
+		return code | 1U;
+	}
+	if (code == 0x4c0)
+	{
+		return 0x4cf;
+	}
+	if (code >= 0x4c1 && code <= 0x4ce)
+	{
+		return code % 2 == 1 ? code + 1 : code;
+	}
+
+	// Armenian
+	if (code >= 0x531 && code <= 0x556)
+	{
+		return code + 0x30;
+	}
+
+	// Latin Extended Additional
+	if ((code >= 0x1e00 && code <= 0x1e95)
+		|| (code >= 0x1ea0 && code <= 0x1eff))
+	{
+		return code | 1U;
+	}
+	if (code == 0x1e9e)
+	{
+		return 0xdf;
+	}
+
+	// Fullwidth Latin
+	if (code >= 0xff21 && code <= 0xff3a)
+	{
+		return code + 0x20;
+	}
+
+	return code;
+}
+
+void strings::append_utf8(std::string &str, char32_t code)
+{
+	if (code < 0x80)
+	{
+		str += static_cast<char>(code);
+	}
+	else if (code < 0x800)
+	{
+		str += static_cast<char>(0xc0 | (code >> 6));
+		str += static_cast<char>(0x80 | (code & 0x3f));
+	}
+	else if (code < 0x10000)
+	{
+		str += static_cast<char>(0xe0 | (code >> 12));
+		str += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+		str += static_cast<char>(0x80 | (code & 0x3f));
+	}
+	else
+	{
+		str += static_cast<char>(0xf0 | (code >> 18));
+		str += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+		str += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+		str += static_cast<char>(0x80 | (code & 0x3f));
+	}
+}
+
 auto strings::to_upper(const std::string &str) -> std::string
 {
 	std::string val(str);
@@ -0,0 +1,108 @@
+#include "lib/tracks/trackcolumns.hpp"
+#include "lib/tracks/tracksortkeys.hpp"
+#include "lib/datetime.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+constexpr std::uint8_t lib::track_columns::flag_local;
+constexpr std::uint8_t lib::track_columns::flag_playable;
+
+lib::track_columns::track_columns(const std::vector<lib::spt::track> &tracks)
+{
+	names.reserve(tracks.size());
+	artists.reserve(tracks.size());
+	albums.reserve(tracks.size());
+	durations.reserve(tracks.size());
+	added.reserve(tracks.size());
+	flags.reserve(tracks.size());
+
+	for (const auto &track : tracks)
+	{
+		push_back(track);
+	}
+}
+
+void lib::track_columns::push_back(const lib::spt::track &track)
+{
+	names.push_back(strings.intern(track.name));
+	artists.push_back(strings.intern(lib::spt::entity::combine_names(track.artists)));
+	albums.push_back(strings.intern(track.album.name));
+	durations.push_back(track.duration);
+
+	added.push_back(track.added_at.empty()
+		? 0
+		: lib::date_time::parse(track.added_at).to_seconds_since_epoch());
+
+	flags.push_back(static_cast<std::uint8_t>((track.is_local ? flag_local : 0U)
+		| (track.is_playable ? flag_playable : 0U)));
+}
+
+auto lib::track_columns::size() const -> size_t
+{
+	return names.size();
+}
+
+auto lib::track_columns::empty() const -> bool
+{
+	return names.empty();
+}
+
+//region Columns
+
+auto lib::track_columns::name(size_t row) const -> const std::string &
+{
+	return names.at(row);
+}
+
+auto lib::track_columns::artist(size_t row) const -> const std::string &
+{
+	return artists.at(row);
+}
+
+auto lib::track_columns::album(size_t row) const -> const std::string &
+{
+	return albums.at(row);
+}
+
+auto lib::track_columns::duration(size_t row) const -> int
+{
+	return durations.at(row);
+}
+
+auto lib::track_columns::added_at(size_t row) const -> std::int64_t
+{
+	return added.at(row);
+}
+
+auto lib::track_columns::is_local(size_t row) const -> bool
+{
+	return (flags.at(row) & flag_local) != 0;
+}
+
+auto lib::track_columns::is_playable(size_t row) const -> bool
+{
+	return (flags.at(row) & flag_playable) != 0;
+}
+
+//endregion
+
+auto lib::track_columns::sort(lib::track_column column, bool ascending) const
+-> std::vector<size_t>
+{
+	return lib::track_sort_keys(*this, column).sort(column, ascending);
+}
+
+auto lib::track_columns::total_duration() const -> long long
+{
+	return std::accumulate(durations.begin(), durations.end(), 0LL);
+}
+
+auto lib::track_columns::playable_count() const -> size_t
+{
+	return static_cast<size_t>(std::count_if(flags.begin(), flags.end(),
+		[](std::uint8_t flag) -> bool
+		{
+			return (flag & flag_playable) != 0 && (flag & flag_local) == 0;
+		}));
+}
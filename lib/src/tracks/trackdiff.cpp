@@ -0,0 +1,157 @@
+#include "lib/tracks/trackdiff.hpp"
+
+#include <unordered_map>
+
+constexpr size_t lib::track_diff::npos;
+
+namespace
+{
+	/**
+	 * Compare keys by text, without copying it
+	 */
+	struct key_hash
+	{
+		auto operator()(const std::string *key) const -> size_t
+		{
+			return std::hash<std::string>()(*key);
+		}
+	};
+
+	struct key_equal
+	{
+		auto operator()(const std::string *key1, const std::string *key2) const -> bool
+		{
+			return *key1 == *key2;
+		}
+	};
+}
+
+lib::track_diff::track_diff(const std::vector<lib::spt::track> &previous,
+	const std::vector<lib::spt::track> &next)
+	: indices(previous.size(), npos),
+	next_size(next.size())
+{
+	// Usually nothing changed, or tracks were only added last
+	size_t same_order = 0;
+	while (same_order < previous.size() && same_order < next.size()
+		&& key(previous[same_order]) == key(next[same_order]))
+	{
+		indices[same_order] = same_order;
+		same_order++;
+	}
+
+	// First index in next for each key, and next index with the same key,
+	// where nth occurrence in previous matches nth occurrence in next
+	std::unordered_map<const std::string *, size_t, key_hash, key_equal> next_keys;
+	std::vector<size_t> same_key(next.size(), npos);
+
+	if (same_order < previous.size())
+	{
+		next_keys.reserve(next.size() - same_order);
+		for (auto i = next.size(); i-- > same_order;)
+		{
+			const auto inserted = next_keys.emplace(&key(next[i]), i);
+			if (!inserted.second)
+			{
+				same_key[i] = inserted.first->second;
+				inserted.first->second = i;
+			}
+		}
+	}
+
+	for (size_t i = same_order; i < previous.size(); i++)
+	{
+		const auto next_key = next_keys.find(&key(previous[i]));
+		if (next_key == next_keys.end() || next_key->second == npos)
+		{
+			continue;
+		}
+
+		indices[i] = next_key->second;
+		next_key->second = same_key[next_key->second];
+	}
+
+	for (size_t i = 0; i < previous.size() && !changed_tracks; i++)
+	{
+		changed_tracks = indices[i] != npos
+			&& !is_same(previous[i], next[indices[i]]);
+	}
+}
+
+auto lib::track_diff::next_indices() const -> const std::vector<size_t> &
+{
+	return indices;
+}
+
+auto lib::track_diff::keys(const std::vector<size_t> &rows) const -> std::vector<size_t>
+{
+	std::vector<size_t> result;
+	result.reserve(rows.size());
+
+	for (const auto row : rows)
+	{
+		const auto index = indices.at(row);
+		result.push_back(index == npos
+			? next_size + row
+			: index);
+	}
+
+	return result;
+}
+
+auto lib::track_diff::empty() const -> bool
+{
+	if (changed_tracks || indices.size() != next_size)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if (indices[i] != i)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+auto lib::track_diff::has_changed_tracks() const -> bool
+{
+	return changed_tracks;
+}
+
+auto lib::track_diff::key(const lib::spt::track &track) -> const std::string &
+{
+	return track.id.empty()
+		? track.name
+		: track.id;
+}
+
+auto lib::track_diff::is_same(const lib::spt::track &track1,
+	const lib::spt::track &track2) -> bool
+{
+	if (track1.name != track2.name
+		|| track1.duration != track2.duration
+		|| track1.added_at != track2.added_at
+		|| track1.is_local != track2.is_local
+		|| track1.is_playable != track2.is_playable
+		|| track1.image != track2.image
+		|| track1.album.id != track2.album.id
+		|| track1.album.name != track2.album.name
+		|| track1.artists.size() != track2.artists.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < track1.artists.size(); i++)
+	{
+		if (track1.artists[i].id != track2.artists[i].id
+			|| track1.artists[i].name != track2.artists[i].name)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
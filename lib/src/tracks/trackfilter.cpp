@@ -0,0 +1,90 @@
+#include "lib/tracks/trackfilter.hpp"
+#include "lib/strings.hpp"
+
+#include <numeric>
+#include <unordered_map>
+
+lib::track_filter::track_filter(const lib::track_columns &columns)
+	: all_rows(columns.size())
+{
+	std::iota(all_rows.begin(), all_rows.end(), 0);
+
+	// Strings are interned, so equal text is at the same address
+	std::unordered_map<const std::string *, std::uint32_t> indices;
+	const auto index = [this, &indices](const std::string &text) -> std::uint32_t
+	{
+		const auto next = static_cast<std::uint32_t>(texts.size());
+		const auto inserted = indices.emplace(&text, next);
+		if (inserted.second)
+		{
+			texts.push_back(lib::strings::fold_case(text));
+		}
+		return inserted.first->second;
+	};
+
+	titles.reserve(columns.size());
+	artists.reserve(columns.size());
+	albums.reserve(columns.size());
+
+	for (size_t row = 0; row < columns.size(); row++)
+	{
+		titles.push_back(index(columns.name(row)));
+		artists.push_back(index(columns.artist(row)));
+		albums.push_back(index(columns.album(row)));
+	}
+}
+
+auto lib::track_filter::size() const -> size_t
+{
+	return all_rows.size();
+}
+
+auto lib::track_filter::filter(const std::string &text) -> const std::vector<size_t> &
+{
+	const auto query = lib::strings::fold_case(text);
+	if (query.empty())
+	{
+		results.clear();
+		return all_rows;
+	}
+
+	// Any row matching query also matches all queries it contains
+	while (!results.empty() && !lib::strings::contains(query, results.back().query))
+	{
+		results.pop_back();
+	}
+
+	if (!results.empty() && results.back().query == query)
+	{
+		return results.back().rows;
+	}
+
+	const auto &candidates = results.empty()
+		? all_rows
+		: results.back().rows;
+
+	// 0 if not checked yet, 1 if not matching, 2 if matching
+	std::vector<std::uint8_t> matches(texts.size(), 0);
+	const auto match = [this, &matches, &query](std::uint32_t index) -> bool
+	{
+		auto &value = matches[index];
+		if (value == 0)
+		{
+			value = texts[index].find(query) != std::string::npos ? 2 : 1;
+		}
+		return value == 2;
+	};
+
+	result next;
+	next.query = query;
+	for (const auto row : candidates)
+	{
+		if (match(titles[row]) || match(artists[row]) || match(albums[row]))
+		{
+			next.rows.push_back(row);
+		}
+	}
+
+	results.push_back(std::move(next));
+	return results.back().rows;
+}
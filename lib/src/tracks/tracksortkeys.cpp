@@ -0,0 +1,186 @@
+#include "lib/tracks/tracksortkeys.hpp"
+#include "lib/strings.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+lib::track_sort_keys::track_sort_keys(const lib::track_columns &columns)
+	: rows(columns.size())
+{
+	for (const auto column: {
+		lib::track_column::title,
+		lib::track_column::artist,
+		lib::track_column::album,
+		lib::track_column::length,
+		lib::track_column::added,
+	})
+	{
+		add(columns, column);
+	}
+}
+
+lib::track_sort_keys::track_sort_keys(const lib::track_columns &columns,
+	lib::track_column column)
+	: rows(columns.size())
+{
+	add(columns, column);
+}
+
+auto lib::track_sort_keys::size() const -> size_t
+{
+	return rows;
+}
+
+auto lib::track_sort_keys::sort(lib::track_column column, bool ascending) const
+-> std::vector<size_t>
+{
+	switch (column)
+	{
+		case lib::track_column::index:
+			break;
+
+		case lib::track_column::title:
+			return sort_by(titles, ascending);
+
+		case lib::track_column::artist:
+			return sort_by(artists, ascending);
+
+		case lib::track_column::album:
+			return sort_by(albums, ascending);
+
+		case lib::track_column::length:
+			return sort_by(durations, ascending);
+
+		case lib::track_column::added:
+			return sort_by(added, ascending);
+	}
+
+	std::vector<size_t> result(rows);
+	std::iota(result.begin(), result.end(), 0);
+	if (!ascending)
+	{
+		std::reverse(result.begin(), result.end());
+	}
+	return result;
+}
+
+void lib::track_sort_keys::add(const lib::track_columns &columns, lib::track_column column)
+{
+	switch (column)
+	{
+		case lib::track_column::index:
+			break;
+
+		case lib::track_column::title:
+			titles = text_ranks(columns, &lib::track_columns::name);
+			break;
+
+		case lib::track_column::artist:
+			artists = text_ranks(columns, &lib::track_columns::artist);
+			break;
+
+		case lib::track_column::album:
+			albums = text_ranks(columns, &lib::track_columns::album);
+			break;
+
+		case lib::track_column::length:
+			durations.reserve(rows);
+			for (size_t row = 0; row < rows; row++)
+			{
+				durations.push_back(columns.duration(row));
+			}
+			break;
+
+		case lib::track_column::added:
+			added.reserve(rows);
+			for (size_t row = 0; row < rows; row++)
+			{
+				added.push_back(columns.added_at(row));
+			}
+			break;
+	}
+}
+
+template<typename T>
+auto lib::track_sort_keys::sort_by(const std::vector<T> &keys, bool ascending) const
+-> std::vector<size_t>
+{
+	if (keys.size() != rows)
+	{
+		throw std::invalid_argument("No sort keys for column");
+	}
+
+	std::vector<size_t> result(rows);
+	std::iota(result.begin(), result.end(), 0);
+
+	if (ascending)
+	{
+		std::stable_sort(result.begin(), result.end(), [&keys](size_t row1, size_t row2) -> bool
+		{
+			return keys[row1] < keys[row2];
+		});
+	}
+	else
+	{
+		std::stable_sort(result.begin(), result.end(), [&keys](size_t row1, size_t row2) -> bool
+		{
+			return keys[row2] < keys[row1];
+		});
+	}
+
+	return result;
+}
+
+auto lib::track_sort_keys::text_ranks(const lib::track_columns &columns,
+	text_column text) -> std::vector<std::uint32_t>
+{
+	const auto size = columns.size();
+
+	std::unordered_map<const std::string *, std::uint32_t> ranks;
+	for (size_t row = 0; row < size; row++)
+	{
+		ranks.emplace(&(columns.*text)(row), 0);
+	}
+
+	std::vector<std::pair<std::string, const std::string *>> unique;
+	unique.reserve(ranks.size());
+	for (const auto &rank : ranks)
+	{
+		unique.emplace_back(sort_text(*rank.first), rank.first);
+	}
+
+	std::sort(unique.begin(), unique.end(),
+		[](const std::pair<std::string, const std::string *> &value1,
+			const std::pair<std::string, const std::string *> &value2) -> bool
+		{
+			return value1.first < value2.first;
+		});
+
+	std::uint32_t rank = 0;
+	for (size_t i = 0; i < unique.size(); i++)
+	{
+		if (i > 0 && unique[i].first != unique[i - 1].first)
+		{
+			rank++;
+		}
+		ranks[unique[i].second] = rank;
+	}
+
+	std::vector<std::uint32_t> result;
+	result.reserve(size);
+	for (size_t row = 0; row < size; row++)
+	{
+		result.push_back(ranks[&(columns.*text)(row)]);
+	}
+	return result;
+}
+
+auto lib::track_sort_keys::sort_text(const std::string &text) -> std::string
+{
+	auto lower = lib::strings::fold_case(text);
+	return lib::strings::starts_with(lower, "the ")
+		? lower.substr(4)
+		: lower;
+}
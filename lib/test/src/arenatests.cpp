@@ -0,0 +1,102 @@
+#include "thirdparty/doctest.h"
+#include "lib/arena.hpp"
+#include "lib/arenajson.hpp"
+#include "lib/spotify/track.hpp"
+
+#include <cstdint>
+
+TEST_CASE("arena")
+{
+	SUBCASE("allocate")
+	{
+		lib::arena arena(64);
+
+		auto *first = static_cast<char *>(arena.allocate(10, 1));
+		auto *second = static_cast<char *>(arena.allocate(8, 8));
+
+		CHECK_EQ(reinterpret_cast<std::uintptr_t>(second) % 8, 0);
+		CHECK(second >= first + 10);
+		CHECK_EQ(arena.capacity(), 64);
+
+		// Doesn't fit in first block
+		arena.allocate(100, 1);
+		CHECK(arena.capacity() > 64);
+		CHECK(arena.used() >= 118);
+	}
+
+	SUBCASE("scope")
+	{
+		CHECK_EQ(lib::arena::current(), nullptr);
+
+		lib::arena outer;
+		lib::arena inner;
+		{
+			lib::arena::scope outer_scope(outer);
+			CHECK_EQ(lib::arena::current(), &outer);
+			{
+				lib::arena::scope inner_scope(inner);
+				CHECK_EQ(lib::arena::current(), &inner);
+			}
+			CHECK_EQ(lib::arena::current(), &outer);
+		}
+		CHECK_EQ(lib::arena::current(), nullptr);
+	}
+
+	SUBCASE("allocator")
+	{
+		lib::arena arena;
+		{
+			lib::arena::scope scope(arena);
+			std::vector<int, lib::arena_allocator<int>> values;
+			for (auto i = 0; i < 100; i++)
+			{
+				values.push_back(i);
+			}
+			CHECK_EQ(values.back(), 99);
+			CHECK(arena.used() >= 100 * sizeof(int));
+		}
+
+		// Falls back to heap without a scope
+		const auto used = arena.used();
+		std::vector<int, lib::arena_allocator<int>> values(100, 1);
+		CHECK_EQ(arena.used(), used);
+	}
+
+	SUBCASE("json")
+	{
+		const std::string data = R"({
+			"added_at": "2021-01-02T03:04:05Z",
+			"is_local": false,
+			"track": {
+				"id": "4uLU6hMCjMI75M1A2tKUQC",
+				"name": "Never Gonna Give You Up",
+				"duration_ms": 213573,
+				"artists": [{"id": "0gxyHStUsqpMadRV0Di1Qt", "name": "Rick Astley"}],
+				"album": {
+					"id": "6XhjNHCyCDyyGJRM5mg40G",
+					"name": "Whenever You Need Somebody",
+					"images": [{"url": "large"}, {"url": "small"}]
+				}
+			}
+		})";
+
+		const auto expected = nlohmann::json::parse(data).get<lib::spt::track>();
+
+		lib::arena arena;
+		lib::spt::track track;
+		{
+			lib::arena::scope scope(arena);
+			track = lib::arena_json::parse(data).get<lib::spt::track>();
+		}
+
+		CHECK(arena.used() > 0);
+		CHECK_EQ(track.id, expected.id);
+		CHECK_EQ(track.name, "Never Gonna Give You Up");
+		CHECK_EQ(track.duration, expected.duration);
+		CHECK_EQ(track.added_at, expected.added_at);
+		REQUIRE_EQ(track.artists.size(), 1);
+		CHECK_EQ(track.artists.front().name, "Rick Astley");
+		CHECK_EQ(track.album.name, expected.album.name);
+		CHECK_EQ(track.image, "small");
+	}
+}
@@ -56,6 +56,12 @@ TEST_CASE("date_time::parse")
 		date_time = lib::date_time::parse("2002-03-04");
 		validate_date(2002, 3, 4);
 	}
+
+	SUBCASE("iso date time with leap second")
+	{
+		date_time = lib::date_time::parse("2021-12-31T23:59:60Z");
+		validate_date(2021, 12, 31, 23, 59, 60);
+	}
 }
 
 TEST_CASE("date_time::to_iso_date(_time)")
@@ -73,4 +79,24 @@ TEST_CASE("date_time::to_iso_date(_time)")
 		date_time = lib::date_time(2008, 9, 10, 11, 12, 14);
 		CHECK_EQ(date_time.to_iso_date_time(), "2008-09-10T11:12:14Z");
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("date_time::seconds_since_epoch")
+{
+	SUBCASE("to")
+	{
+		CHECK_EQ(lib::date_time(1970, 1, 1, 0, 0, 0).to_seconds_since_epoch(), 0);
+		CHECK_EQ(lib::date_time(2021, 3, 1, 12, 30, 15).to_seconds_since_epoch(), 1614601815);
+		CHECK_EQ(lib::date_time::parse("2020-02-29T23:59:59Z").to_seconds_since_epoch(),
+			1583020799);
+	}
+
+	SUBCASE("from")
+	{
+		auto date = lib::date_time::from_seconds_since_epoch(1614601815);
+		CHECK_EQ(date.to_iso_date_time(), "2021-03-01T12:30:15Z");
+
+		date = lib::date_time::from_seconds_since_epoch(1583020799);
+		CHECK_EQ(date.to_iso_date_time(), "2020-02-29T23:59:59Z");
+	}
+}
@@ -0,0 +1,23 @@
+#include "thirdparty/doctest.h"
+#include "lib/hash.hpp"
+
+TEST_CASE("hash::fnv1a")
+{
+	SUBCASE("empty")
+	{
+		CHECK_EQ(lib::hash::fnv1a(std::string()), lib::hash::offset_basis);
+	}
+
+	SUBCASE("known")
+	{
+		CHECK_EQ(lib::hash::fnv1a(std::string("a")), 0xaf63dc4c8601ec8cULL);
+		CHECK_EQ(lib::hash::fnv1a(std::string("foobar")), 0x85944171f73967e8ULL);
+	}
+
+	SUBCASE("continue")
+	{
+		auto hash = lib::hash::fnv1a(std::string("foo"));
+		CHECK_EQ(lib::hash::fnv1a(std::string("bar"), hash),
+			lib::hash::fnv1a(std::string("foobar")));
+	}
+}
@@ -0,0 +1,77 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/api.hpp"
+#include "lib/spotify/id.hpp"
+
+#include <unordered_set>
+
+TEST_CASE("spt::id")
+{
+	SUBCASE("size")
+	{
+		CHECK(sizeof(lib::spt::id) == 16);
+	}
+
+	SUBCASE("round trip")
+	{
+		for (const auto &value : {
+			"4uLU6hMCjMI75M1A2tKUQC",
+			"0000000000000000000000",
+			"0000000000000000000001",
+			"7N42dgm5tFLK9N8MT7fHC6",
+		})
+		{
+			const lib::spt::id id(value);
+			CHECK(id.is_valid());
+			CHECK(id.to_string() == value);
+		}
+	}
+
+	SUBCASE("invalid")
+	{
+		CHECK_FALSE(lib::spt::id().is_valid());
+		CHECK_FALSE(lib::spt::id("").is_valid());
+		CHECK_FALSE(lib::spt::id("4uLU6hMCjMI75M1A2tKUQ").is_valid());
+		CHECK_FALSE(lib::spt::id("4uLU6hMCjMI75M1A2tKUQC0").is_valid());
+		CHECK_FALSE(lib::spt::id("4uLU6hMCjMI75M1A2tKU-C").is_valid());
+		CHECK_FALSE(lib::spt::id("spotify:local:a:b:c:1").is_valid());
+
+		// Larger than 128 bits
+		CHECK_FALSE(lib::spt::id("7N42dgm5tFLK9N8MT7fHC8").is_valid());
+		CHECK_FALSE(lib::spt::id("ZZZZZZZZZZZZZZZZZZZZZZ").is_valid());
+
+		// All bits set
+		CHECK_FALSE(lib::spt::id("7N42dgm5tFLK9N8MT7fHC7").is_valid());
+
+		CHECK(lib::spt::id().to_string().empty());
+		CHECK(lib::spt::id("a") == lib::spt::id());
+	}
+
+	SUBCASE("compare")
+	{
+		const lib::spt::id id1("0000000000000000000001");
+		const lib::spt::id id2("00000000000lYGhA16ahyg"); // 2^64
+		const lib::spt::id id3("4uLU6hMCjMI75M1A2tKUQC");
+
+		CHECK(id1 < id2);
+		CHECK(id2 < id3);
+		CHECK_FALSE(id3 < id1);
+		CHECK(id3 == lib::spt::id("4uLU6hMCjMI75M1A2tKUQC"));
+		CHECK(id1 != id2);
+
+		std::unordered_set<lib::spt::id> ids{id1, id2, id3, id3};
+		CHECK(ids.size() == 3);
+		CHECK(ids.find(lib::spt::id("00000000000lYGhA16ahyg")) != ids.end());
+	}
+
+	SUBCASE("uri")
+	{
+		const std::string uri = "spotify:track:4uLU6hMCjMI75M1A2tKUQC";
+		const auto id = lib::spt::api::to_packed_id(uri);
+
+		CHECK(id.is_valid());
+		CHECK(id == lib::spt::api::to_packed_id("4uLU6hMCjMI75M1A2tKUQC"));
+		CHECK_FALSE(lib::spt::api::to_packed_id("spotify:local:a:b:c:1").is_valid());
+		CHECK(lib::spt::api::to_uri("track", id) == uri);
+		CHECK(lib::spt::api::to_uri("track", lib::spt::id()).empty());
+	}
+}
@@ -0,0 +1,335 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/jsoncache.hpp"
+#include "lib/cache/cachewarmup.hpp"
+#include "lib/cache/cachedtracks.hpp"
+#include "testtracks.hpp"
+
+#include <atomic>
+#include <thread>
+
+class cache_test_paths: public lib::paths
+{
+public:
+	cache_test_paths()
+	{
+		lib::log::set_log_to_stdout(false);
+	}
+
+	~cache_test_paths()
+	{
+		ghc::filesystem::remove_all(cache());
+	}
+
+	auto config_file() const -> ghc::filesystem::path override
+	{
+		return "spotify-qt-cache-test.json";
+	}
+
+	auto cache() const -> ghc::filesystem::path override
+	{
+		return "cache-test";
+	}
+};
+
+TEST_CASE("json_cache")
+{
+	cache_test_paths paths;
+
+	SUBCASE("manifest")
+	{
+		{
+			lib::json_cache cache(paths);
+			cache.set_tracks("a", test_tracks::tracks(2));
+			cache.set_tracks("b", test_tracks::tracks(3));
+
+			auto usage = cache.get_usage();
+			CHECK_EQ(usage["tracks"].count, 2);
+			CHECK(usage["tracks"].size > 0);
+		}
+
+		// Manifest is loaded again, not rebuilt
+		CHECK(ghc::filesystem::exists(paths.cache() / "manifest.json"));
+		CHECK_FALSE(ghc::filesystem::exists(paths.cache() / "manifest.json.tmp"));
+		lib::json_cache cache(paths);
+		CHECK_EQ(cache.get_usage()["tracks"].count, 2);
+
+		std::map<std::string, size_t> all;
+		cache.all_tracks([&all](const std::string &id,
+			const std::vector<lib::spt::track> &tracks) -> bool
+		{
+			all[id] = tracks.size();
+			return true;
+		});
+		REQUIRE_EQ(all.size(), 2);
+		CHECK_EQ(all["a"], 2);
+		CHECK_EQ(all["b"], 3);
+	}
+
+	SUBCASE("all_tracks stops")
+	{
+		lib::json_cache cache(paths);
+		cache.set_tracks("a", test_tracks::tracks(1));
+		cache.set_tracks("b", test_tracks::tracks(1));
+
+		auto count = 0;
+		cache.all_tracks([&count](const std::string &/*id*/,
+			const std::vector<lib::spt::track> &/*tracks*/) -> bool
+		{
+			count++;
+			return false;
+		});
+		CHECK_EQ(count, 1);
+	}
+
+	SUBCASE("rebuild")
+	{
+		{
+			lib::json_cache cache(paths);
+			cache.set_tracks("a", test_tracks::tracks(1));
+		}
+
+		ghc::filesystem::remove(paths.cache() / "manifest.json");
+		ghc::filesystem::remove(paths.cache() / "manifest.journal");
+
+		lib::json_cache cache(paths);
+		CHECK_EQ(cache.get_usage()["tracks"].count, 1);
+		CHECK_EQ(cache.get_tracks("a").size(), 1);
+	}
+
+	SUBCASE("cached_tracks")
+	{
+		lib::json_cache cache(paths);
+		cache.set_tracks("a", test_tracks::tracks(2));
+		cache.set_tracks("b", test_tracks::tracks(3));
+
+		const auto columns = lib::cached_tracks::load(cache);
+		REQUIRE_EQ(columns.size(), 5);
+
+		// Same track in both lists, stored once, in whichever order lists are loaded
+		const auto other = columns.name(2) == columns.name(0) ? 2 : 3;
+		CHECK_EQ(&columns.name(0), &columns.name(other));
+		CHECK_EQ(&columns.album(0), &columns.album(4));
+	}
+
+	SUBCASE("removed directory")
+	{
+		lib::json_cache cache(paths);
+		CHECK(ghc::filesystem::is_directory(paths.cache() / "tracks"));
+
+		ghc::filesystem::remove_all(paths.cache() / "tracks");
+		cache.set_tracks("a", test_tracks::tracks(1));
+		CHECK_EQ(cache.get_tracks("a").size(), 1);
+	}
+
+	SUBCASE("evict")
+	{
+		lib::json_cache cache(paths);
+		cache.set_album_image("https://example.com/a", std::vector<unsigned char>(10));
+		cache.set_album_image("https://example.com/b", std::vector<unsigned char>(10));
+
+		CHECK_EQ(cache.evict("album", 10), 1);
+		CHECK_EQ(cache.get_usage()["album"].count, 1);
+		CHECK_EQ(cache.evict("album", 10), 0);
+	}
+
+	SUBCASE("album image names")
+	{
+		lib::json_cache cache(paths);
+		const std::vector<unsigned char> data(10);
+		cache.set_album_image("https://example.com/image/a", data);
+		cache.set_album_image("https://example.com/image/b.jpg", 32, data);
+		cache.set_album_image("c", data);
+
+		CHECK(ghc::filesystem::exists(paths.cache() / "album" / "a"));
+		CHECK(ghc::filesystem::exists(paths.cache() / "album" / "b.32"));
+		CHECK(ghc::filesystem::exists(paths.cache() / "album" / "c"));
+		CHECK_EQ(cache.get_album_image("https://example.com/image/b.jpg", 32).size(), 10);
+	}
+
+	SUBCASE("unchanged writes are skipped")
+	{
+		lib::json_cache cache(paths);
+		auto tracks = test_tracks::tracks(2);
+
+		cache.set_tracks("a", tracks);
+		cache.set_tracks("a", tracks);
+		CHECK_EQ(cache.get_writes().written, 1);
+		CHECK_EQ(cache.get_writes().skipped, 1);
+
+		tracks.at(1).name = "Changed";
+		cache.set_tracks("a", tracks);
+		CHECK_EQ(cache.get_writes().written, 2);
+		CHECK_EQ(cache.get_tracks("a").at(1).name, "Changed");
+
+		lib::spt::playlist playlist;
+		playlist.id = "playlist";
+		cache.set_playlists({playlist});
+		cache.set_playlists({playlist});
+		CHECK_EQ(cache.get_writes().skipped, 2);
+
+		// Deleted files are written again
+		ghc::filesystem::remove(paths.cache() / "tracks" / "a.json");
+		cache.set_tracks("a", tracks);
+		CHECK_EQ(cache.get_writes().written, 4);
+	}
+
+	SUBCASE("concurrent readers and writers")
+	{
+		lib::json_cache cache(paths);
+		const std::vector<std::string> ids = {"a", "b", "c"};
+		const std::string url = "https://example.com/album";
+
+		constexpr int thread_count = 8;
+		constexpr int iterations = 50;
+
+		std::atomic<int> invalid(0);
+		std::vector<std::thread> threads;
+
+		for (auto t = 0; t < thread_count; t++)
+		{
+			threads.emplace_back([&, t]()
+			{
+				for (auto i = 0; i < iterations; i++)
+				{
+					const auto &id = ids.at(static_cast<size_t>(i + t) % ids.size());
+
+					if (t % 2 == 0)
+					{
+						cache.set_tracks(id, test_tracks::tracks(1 + (i + t) % 5));
+						cache.set_album_image(url, 32, std::vector<unsigned char>(
+							static_cast<size_t>(100 + t), static_cast<unsigned char>(t)));
+						continue;
+					}
+
+					// Tracks are either missing, or complete
+					const auto tracks = cache.get_tracks(id);
+					for (size_t j = 0; j < tracks.size(); j++)
+					{
+						if (tracks.at(j).id != lib::fmt::format("track{}", j)
+							|| tracks.at(j).artists.size() != 1)
+						{
+							invalid++;
+						}
+					}
+
+					// Images are never mixed from different writers
+					const auto image = cache.get_album_image(url, 32);
+					for (const auto byte : image)
+					{
+						if (byte != image.front())
+						{
+							invalid++;
+							break;
+						}
+					}
+				}
+			});
+		}
+
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		CHECK_EQ(invalid, 0);
+		CHECK_EQ(cache.get_usage()["tracks"].count, ids.size());
+		CHECK_EQ(cache.get_usage()["album"].count, 1);
+	}
+
+	SUBCASE("verify")
+	{
+		const std::vector<unsigned char> jpeg{0xff, 0xd8, 0xff, 0xe0};
+		lib::json_cache cache(paths);
+
+		auto tracks = test_tracks::tracks(1);
+		tracks.at(0).image = "https://example.com/used";
+		cache.set_tracks("a", tracks);
+		cache.set_album_image("https://example.com/used", jpeg);
+		cache.set_album_image("https://example.com/used", 32, jpeg);
+		cache.set_album_image("https://example.com/unused", jpeg);
+
+		std::ofstream(paths.cache() / "tracks" / "b.json") << "{";
+		std::ofstream(paths.cache() / "tracks" / "c.json.tmp") << "[]";
+
+		CHECK_EQ(cache.verify(false).size(), 3);
+		CHECK(ghc::filesystem::exists(paths.cache() / "album" / "unused"));
+
+		CHECK_EQ(cache.verify(true).size(), 3);
+		CHECK_FALSE(ghc::filesystem::exists(paths.cache() / "album" / "unused"));
+		CHECK(ghc::filesystem::exists(paths.cache() / "album" / "used.32"));
+		CHECK(cache.verify(false).empty());
+	}
+
+	SUBCASE("read only")
+	{
+		ghc::filesystem::create_directories(paths.cache() / "tracks");
+		std::ofstream(paths.cache() / "tracks" / "a.json") << "{";
+
+		{
+			lib::json_cache cache(paths, true);
+			CHECK_EQ(cache.get_usage()["tracks"].count, 1);
+			CHECK_EQ(cache.verify(false).size(), 1);
+		}
+
+		CHECK_FALSE(ghc::filesystem::exists(paths.cache() / "manifest.json"));
+		CHECK_FALSE(ghc::filesystem::exists(paths.cache() / "album"));
+	}
+
+	SUBCASE("compact")
+	{
+		{
+			lib::json_cache cache(paths);
+		}
+
+		// Saved by an older version, without manifest
+		nlohmann::json legacy = test_tracks::tracks(3);
+		std::ofstream(paths.cache() / "tracks" / "a.json") << legacy.dump(4);
+		ghc::filesystem::remove(paths.cache() / "manifest.json");
+		ghc::filesystem::remove(paths.cache() / "manifest.journal");
+
+		lib::json_cache cache(paths);
+		CHECK_EQ(cache.compact(), 1);
+		CHECK_EQ(cache.compact(), 0);
+
+		auto json = lib::json::load(paths.cache() / "tracks" / "a.json");
+		CHECK(lib::normalized_tracks::is_normalized(json));
+		CHECK_EQ(cache.get_tracks("a").size(), 3);
+	}
+
+	SUBCASE("normalized playlist")
+	{
+		lib::json_cache cache(paths);
+
+		lib::spt::playlist playlist;
+		playlist.id = "playlist";
+		playlist.name = "Playlist";
+		playlist.tracks = test_tracks::tracks(3);
+		cache.set_playlist(playlist);
+
+		auto result = cache.get_playlist("playlist");
+		CHECK_EQ(result.name, "Playlist");
+		REQUIRE_EQ(result.tracks.size(), 3);
+		CHECK_EQ(result.tracks.at(2).id, "track2");
+		CHECK_EQ(result.tracks.at(2).album.name, "Album");
+		REQUIRE_EQ(result.tracks.at(2).artists.size(), 1);
+		CHECK_EQ(result.tracks.at(2).artists.at(0).name, "Artist");
+	}
+
+	SUBCASE("warm up")
+	{
+		lib::json_cache cache(paths);
+
+		lib::spt::playlist playlist;
+		playlist.id = "playlist";
+		playlist.tracks = test_tracks::tracks(4);
+		cache.set_playlist(playlist);
+		cache.set_playlists({playlist});
+		cache.set_tracks(lib::cache_warm_up::liked_tracks_id, test_tracks::tracks(2));
+
+		lib::cache_warm_up warm_up(cache, "spotify:playlist:playlist");
+		warm_up.wait();
+		CHECK_EQ(warm_up.playlists().size(), 1);
+		CHECK_EQ(warm_up.last_playlist().tracks.size(), 4);
+		CHECK_EQ(warm_up.liked_tracks().size(), 2);
+	}
+}
@@ -49,4 +49,19 @@ TEST_CASE("json")
 		lib::json::get(json, "d", value);
 		CHECK_EQ(value, 1);
 	}
+
+	SUBCASE("read_file")
+	{
+		const ghc::filesystem::path path = "json-read-file-test.json";
+		lib::json::save(path, json);
+
+		std::vector<unsigned char> data;
+		CHECK(lib::json::read_file(path, data));
+		CHECK_EQ(data.size(), ghc::filesystem::file_size(path));
+		CHECK_EQ(lib::json::parse_file(path), json);
+
+		ghc::filesystem::remove(path);
+		CHECK_FALSE(lib::json::read_file(path, data));
+		CHECK(lib::json::parse_file(path).is_null());
+	}
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "thirdparty/doctest.h"
+#include "lib/listdiff.hpp"
+
+#include <algorithm>
+
+namespace
+{
+	/**
+	 * Apply changes to previous, which should then equal next
+	 */
+	auto apply_diff(std::vector<size_t> previous, const std::vector<size_t> &next,
+		const lib::list_diff &diff) -> std::vector<size_t>
+	{
+		for (const auto &change : diff.changes())
+		{
+			switch (change.type)
+			{
+				case lib::list_diff::change_type::remove:
+					REQUIRE(change.from < previous.size());
+					previous.erase(previous.begin() + static_cast<long>(change.from));
+					break;
+
+				case lib::list_diff::change_type::insert:
+					REQUIRE(change.to <= previous.size());
+					previous.insert(previous.begin() + static_cast<long>(change.to),
+						next.at(change.from));
+					break;
+
+				case lib::list_diff::change_type::move:
+				{
+					REQUIRE(change.from < previous.size());
+					REQUIRE(change.to <= previous.size());
+					CHECK(change.to != change.from);
+					CHECK(change.to != change.from + 1);
+
+					const auto value = previous.at(change.from);
+					previous.erase(previous.begin() + static_cast<long>(change.from));
+					const auto to = change.to > change.from ? change.to - 1 : change.to;
+					previous.insert(previous.begin() + static_cast<long>(to), value);
+					break;
+				}
+			}
+		}
+		return previous;
+	}
+
+	auto change_count(const lib::list_diff &diff, lib::list_diff::change_type type) -> size_t
+	{
+		return static_cast<size_t>(std::count_if(diff.changes().begin(), diff.changes().end(),
+			[type](const lib::list_diff::change &change) -> bool
+			{
+				return change.type == type;
+			}));
+	}
+}
+
+TEST_CASE("list_diff")
+{
+	SUBCASE("equal")
+	{
+		const std::vector<size_t> list{1, 2, 3};
+		const lib::list_diff diff(list, list);
+		CHECK(diff.empty());
+		CHECK_FALSE(diff.exceeds_limit());
+		CHECK(lib::list_diff({}, {}).empty());
+	}
+
+	SUBCASE("remove and insert")
+	{
+		const std::vector<size_t> previous{1, 2, 3, 4};
+		const std::vector<size_t> next{5, 1, 3, 6, 4, 7};
+		const lib::list_diff diff(previous, next);
+
+		CHECK(change_count(diff, lib::list_diff::change_type::remove) == 1);
+		CHECK(change_count(diff, lib::list_diff::change_type::insert) == 3);
+		CHECK(change_count(diff, lib::list_diff::change_type::move) == 0);
+		CHECK(apply_diff(previous, next, diff) == next);
+	}
+
+	SUBCASE("fewest moves")
+	{
+		const std::vector<size_t> previous{1, 2, 3, 4, 5};
+
+		const std::vector<size_t> last_first{5, 1, 2, 3, 4};
+		const lib::list_diff diff1(previous, last_first);
+		REQUIRE(diff1.changes().size() == 1);
+		CHECK(apply_diff(previous, last_first, diff1) == last_first);
+
+		const std::vector<size_t> first_last{2, 3, 4, 5, 1};
+		const lib::list_diff diff2(previous, first_last);
+		REQUIRE(diff2.changes().size() == 1);
+		CHECK(apply_diff(previous, first_last, diff2) == first_last);
+
+		const std::vector<size_t> reversed{5, 4, 3, 2, 1};
+		const lib::list_diff diff3(previous, reversed);
+		CHECK(diff3.changes().size() == 4);
+		CHECK(apply_diff(previous, reversed, diff3) == reversed);
+	}
+
+	SUBCASE("shuffled")
+	{
+		std::vector<size_t> previous;
+		for (size_t i = 0; i < 200; i++)
+		{
+			previous.push_back(i);
+		}
+
+		// Remove every 7th, move every 11th to front, add new after every 13th
+		std::vector<size_t> next;
+		std::vector<size_t> moved;
+		for (const auto value : previous)
+		{
+			if (value % 7 == 0)
+			{
+				continue;
+			}
+			if (value % 11 == 0)
+			{
+				moved.push_back(value);
+				continue;
+			}
+			next.push_back(value);
+			if (value % 13 == 0)
+			{
+				next.push_back(1000 + value);
+			}
+		}
+		next.insert(next.begin(), moved.begin(), moved.end());
+
+		const lib::list_diff diff(previous, next);
+		CHECK(apply_diff(previous, next, diff) == next);
+		CHECK(change_count(diff, lib::list_diff::change_type::remove) == 29);
+		CHECK(change_count(diff, lib::list_diff::change_type::move) <= moved.size());
+	}
+
+	SUBCASE("limit")
+	{
+		const lib::list_diff diff({1, 2, 3}, {3, 4, 5}, 2);
+		CHECK(diff.exceeds_limit());
+		CHECK_FALSE(diff.empty());
+		CHECK(diff.changes().empty());
+	}
+}
@@ -0,0 +1,298 @@
+#include "thirdparty/doctest.h"
+#include "lib/history/listeninghistory.hpp"
+#include "lib/log.hpp"
+#include "testtracks.hpp"
+
+#include <fstream>
+
+namespace
+{
+	class history_dir
+	{
+	public:
+		history_dir()
+		{
+			lib::log::set_log_to_stdout(false);
+			ghc::filesystem::remove_all(path);
+		}
+
+		~history_dir()
+		{
+			ghc::filesystem::remove_all(path);
+		}
+
+		const ghc::filesystem::path path = "history-test";
+	};
+}
+
+TEST_CASE("listening_history")
+{
+	history_dir dir;
+
+	// 2021-03-01 12:00:00
+	constexpr std::int64_t march = 1614600000;
+	// 2021-02-28 12:00:00
+	constexpr std::int64_t february = 1614513600;
+
+	SUBCASE("add and reload")
+	{
+		{
+			lib::listening_history history(dir.path);
+			CHECK(history.add(test_tracks::track("a"), march));
+			CHECK(history.add(test_tracks::track("b"), march + 200));
+			CHECK(history.add(test_tracks::track("a"), march + 400));
+			CHECK(history.newest() == march + 400);
+		}
+
+		lib::listening_history history(dir.path);
+		CHECK(history.months() == std::vector<int>{202103});
+		CHECK(history.newest() == march + 400);
+
+		const auto plays = history.month(202103);
+		REQUIRE(plays.size() == 3);
+		CHECK(plays[0].played_at == march + 400);
+		CHECK(plays[0].track.id == "a");
+		CHECK(plays[1].track.id == "b");
+		CHECK(plays[2].track.name == "Track a");
+		CHECK(plays[2].track.duration == 180000);
+		REQUIRE(plays[2].track.artists.size() == 1);
+		CHECK(plays[2].track.artists[0].name == "Artist");
+	}
+
+	SUBCASE("duplicate plays")
+	{
+		lib::listening_history history(dir.path);
+		CHECK(history.add(test_tracks::track("a"), march));
+		CHECK_FALSE(history.add(test_tracks::track("a"), march + 5));
+		CHECK_FALSE(history.add(test_tracks::track("a"), march - 5));
+		CHECK(history.add(test_tracks::track("b"), march + 5));
+		CHECK(history.month(202103).size() == 2);
+	}
+
+	SUBCASE("same play from both sources")
+	{
+		const auto started = lib::play_source::started;
+
+		lib::listening_history history(dir.path);
+		CHECK(history.add(test_tracks::track("a"), march, started));
+		CHECK_FALSE(history.add(test_tracks::track("a"), march + 2, started));
+
+		// Stopped a bit later than its duration, after a short pause
+		CHECK_FALSE(history.add(test_tracks::track("a"), march + 200));
+		CHECK(history.month(202103).size() == 1);
+
+		// Also when recently played tracks are synced first
+		CHECK(history.add(test_tracks::track("b"), march + 1000));
+		CHECK_FALSE(history.add(test_tracks::track("b"), march + 820, started));
+		CHECK(history.month(202103).size() == 2);
+	}
+
+	SUBCASE("repeated track")
+	{
+		const auto started = lib::play_source::started;
+		const auto duration = test_tracks::track("a").duration / 1000;
+
+		lib::listening_history history(dir.path);
+		CHECK(history.add(test_tracks::track("a"), march, started));
+		CHECK(history.add(test_tracks::track("a"), march + duration, started));
+		CHECK(history.add(test_tracks::track("a"), march + duration * 2, started));
+
+		// Recently played, each ending when the next one started
+		CHECK_FALSE(history.add(test_tracks::track("a"), march + duration));
+		CHECK_FALSE(history.add(test_tracks::track("a"), march + duration * 2));
+		CHECK_FALSE(history.add(test_tracks::track("a"), march + duration * 3));
+		CHECK(history.month(202103).size() == 3);
+
+		// First play synced before the track was played again
+		CHECK(history.add(test_tracks::track("b"), march + 2000));
+		CHECK(history.add(test_tracks::track("b"), march + 2000, started));
+		CHECK(history.month(202103).size() == 5);
+	}
+
+	SUBCASE("before across months")
+	{
+		lib::listening_history history(dir.path);
+		CHECK(history.add(test_tracks::track("a"), february));
+		CHECK(history.add(test_tracks::track("b"), february + 1000));
+		CHECK(history.add(test_tracks::track("c"), march));
+
+		CHECK(history.months() == std::vector<int>{202103, 202102});
+
+		const auto plays = history.before(march + 1, 2);
+		REQUIRE(plays.size() == 2);
+		CHECK(plays[0].track.id == "c");
+		CHECK(plays[1].track.id == "b");
+
+		const auto older = history.before(february + 1000, 10);
+		REQUIRE(older.size() == 1);
+		CHECK(older[0].track.id == "a");
+	}
+
+	SUBCASE("truncated segment")
+	{
+		{
+			lib::listening_history history(dir.path);
+			CHECK(history.add(test_tracks::track("a"), march));
+			CHECK(history.add(test_tracks::track("b"), march + 200));
+		}
+
+		const auto file = dir.path / "2021-03.bin";
+		ghc::filesystem::resize_file(file, ghc::filesystem::file_size(file) - 3);
+
+		{
+			lib::listening_history history(dir.path);
+			CHECK(history.month(202103).size() == 1);
+			CHECK(history.add(test_tracks::track("c"), march + 400));
+		}
+
+		lib::listening_history history(dir.path);
+		const auto plays = history.month(202103);
+		REQUIRE(plays.size() == 2);
+		CHECK(plays[0].track.id == "c");
+		CHECK(plays[1].track.id == "a");
+	}
+
+	SUBCASE("invalid segment")
+	{
+		ghc::filesystem::create_directories(dir.path);
+		const auto file = dir.path / "2021-03.bin";
+		std::ofstream(file, std::ios::binary) << "not a segment";
+
+		{
+			lib::listening_history history(dir.path);
+			CHECK(history.month(202103).empty());
+			CHECK(history.add(test_tracks::track("a"), march));
+		}
+
+		CHECK(ghc::filesystem::exists(dir.path / "2021-03.bin.invalid"));
+
+		lib::listening_history history(dir.path);
+		CHECK(history.months() == std::vector<int>{202103});
+		const auto plays = history.month(202103);
+		REQUIRE(plays.size() == 1);
+		CHECK(plays[0].track.id == "a");
+	}
+
+	SUBCASE("long text")
+	{
+		// Last character doesn't fit, and isn't split
+		auto track = test_tracks::track("a");
+		track.name = std::string(65534, 'a') + "\xc3\xa9";
+
+		{
+			lib::listening_history history(dir.path);
+			CHECK(history.add(track, march));
+			CHECK(history.add(test_tracks::track("b"), march + 200));
+		}
+
+		lib::listening_history history(dir.path);
+		const auto plays = history.month(202103);
+		REQUIRE(plays.size() == 2);
+		CHECK(plays[0].track.id == "b");
+		CHECK(plays[1].track.name == std::string(65534, 'a'));
+	}
+}
+
+TEST_CASE("listening_stats")
+{
+	// 2021-03-01 12:00:00, a Monday
+	constexpr std::int64_t monday = 1614600000;
+
+	lib::listening_stats stats(0);
+	stats.add(test_tracks::track("a"), monday);
+	stats.add(test_tracks::track("b"), monday + 3600);
+	stats.add(test_tracks::track("a"), monday + 24 * 60 * 60);
+
+	SUBCASE("top")
+	{
+		const auto tracks = stats.top_tracks(1);
+		REQUIRE(tracks.size() == 1);
+		CHECK(tracks[0].id == "a");
+		CHECK(tracks[0].plays == 2);
+		CHECK(tracks[0].duration == 360000);
+		CHECK(tracks[0].last_played == monday + 24 * 60 * 60);
+
+		CHECK(stats.top_tracks(10).size() == 2);
+
+		const auto artists = stats.top_artists(10);
+		REQUIRE(artists.size() == 1);
+		CHECK(artists[0].name == "Artist");
+		CHECK(artists[0].plays == 3);
+
+		CHECK(stats.top_albums(10).front().plays == 3);
+		CHECK(stats.plays() == 3);
+		CHECK(stats.duration() == 540000);
+	}
+
+	SUBCASE("time")
+	{
+		CHECK(stats.hours()[12] == 2);
+		CHECK(stats.hours()[13] == 1);
+		CHECK(stats.week_days()[0] == 2);
+		CHECK(stats.week_days()[1] == 1);
+		CHECK(stats.days().size() == 2);
+		CHECK(stats.days().begin()->first == monday / (24 * 60 * 60));
+	}
+
+	SUBCASE("utc offset")
+	{
+		lib::listening_stats local(-13 * 60 * 60);
+		local.add(test_tracks::track("a"), monday);
+		CHECK(local.hours()[23] == 1);
+		CHECK(local.week_days()[6] == 1);
+	}
+
+	SUBCASE("json")
+	{
+		const nlohmann::json json = stats;
+		const auto loaded = json.get<lib::listening_stats>();
+		CHECK(loaded.plays() == 3);
+		CHECK(loaded.top_tracks(1).front().plays == 2);
+		CHECK(loaded.hours() == stats.hours());
+		CHECK(loaded.days() == stats.days());
+	}
+}
+
+TEST_CASE("listening_history::stats")
+{
+	history_dir dir;
+	constexpr std::int64_t march = 1614600000;
+
+	{
+		lib::listening_history history(dir.path);
+		CHECK(history.stats().plays() == 0);
+		CHECK(history.add(test_tracks::track("a"), march));
+		CHECK(history.add(test_tracks::track("b"), march + 200));
+		CHECK(history.stats().plays() == 2);
+	}
+
+	// Loaded from saved statistics
+	{
+		lib::listening_history history(dir.path);
+		CHECK(history.stats().plays() == 2);
+		CHECK(history.add(test_tracks::track("a"), march + 400));
+		CHECK(history.stats().top_tracks(1).front().plays == 2);
+	}
+
+	// Plays added before loading are included, also in new months
+	{
+		lib::listening_history history(dir.path);
+		CHECK(history.add(test_tracks::track("c"), march + 600));
+		CHECK(history.add(test_tracks::track("c"), march + 31 * 24 * 60 * 60));
+		CHECK(history.stats().plays() == 5);
+		CHECK(history.stats().top_tracks(1).front().plays == 2);
+	}
+
+	// Rebuilt when out of date
+	ghc::filesystem::remove(dir.path / "stats.json");
+	{
+		lib::listening_history history(dir.path);
+		CHECK(history.stats().plays() == 5);
+	}
+
+	// Not loaded only to add a play
+	ghc::filesystem::remove(dir.path / "stats.json");
+	lib::listening_history history(dir.path);
+	CHECK(history.add(test_tracks::track("d"), march + 800));
+	CHECK_FALSE(ghc::filesystem::exists(dir.path / "stats.json"));
+}
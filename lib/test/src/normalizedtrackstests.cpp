@@ -0,0 +1,111 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/normalizedtracks.hpp"
+
+namespace
+{
+	auto normalized_test_tracks() -> std::vector<lib::spt::track>
+	{
+		std::vector<lib::spt::track> tracks;
+
+		lib::spt::entity artist1;
+		artist1.id = "artist1";
+		artist1.name = "Artist 1";
+
+		lib::spt::entity artist2;
+		artist2.id = "artist2";
+		artist2.name = "Artist 2";
+
+		for (auto i = 0; i < 10; i++)
+		{
+			lib::spt::track track;
+			track.id = lib::fmt::format("track{}", i);
+			track.name = lib::fmt::format("Track {}", i);
+			track.duration = i * 1000;
+			track.album.id = i < 5 ? "album1" : "album2";
+			track.album.name = i < 5 ? "Album 1" : "Album 2";
+			track.image = lib::fmt::format("https://example.com/{}", track.album.id);
+			track.artists.push_back(artist1);
+			if (i % 2 == 0)
+			{
+				track.artists.push_back(artist2);
+			}
+			tracks.push_back(track);
+		}
+
+		tracks.at(1).is_local = true;
+		tracks.at(2).is_playable = false;
+		tracks.at(3).added_at = "2020-01-01T00:00:00Z";
+
+		return tracks;
+	}
+
+	auto normalized_equal(const lib::spt::track &a, const lib::spt::track &b) -> bool
+	{
+		if (a.artists.size() != b.artists.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.artists.size(); i++)
+		{
+			if (a.artists.at(i).id != b.artists.at(i).id
+				|| a.artists.at(i).name != b.artists.at(i).name)
+			{
+				return false;
+			}
+		}
+
+		return a.id == b.id
+			&& a.name == b.name
+			&& a.duration == b.duration
+			&& a.is_local == b.is_local
+			&& a.is_playable == b.is_playable
+			&& a.added_at == b.added_at
+			&& a.image == b.image
+			&& a.album.id == b.album.id
+			&& a.album.name == b.album.name;
+	}
+}
+
+TEST_CASE("normalized_tracks")
+{
+	const auto tracks = normalized_test_tracks();
+
+	SUBCASE("entities are stored once")
+	{
+		auto json = lib::normalized_tracks::to_json(tracks);
+		CHECK(lib::normalized_tracks::is_normalized(json));
+		CHECK_EQ(json.at("artists").size(), 2);
+		CHECK_EQ(json.at("albums").size(), 2);
+		CHECK_EQ(json.at("tracks").size(), tracks.size());
+
+		nlohmann::json legacy = tracks;
+		CHECK(json.dump().size() < legacy.dump().size());
+	}
+
+	SUBCASE("round trip")
+	{
+		auto json = lib::normalized_tracks::to_json(tracks);
+		auto result = lib::normalized_tracks::from_json(json);
+		REQUIRE_EQ(result.size(), tracks.size());
+		for (size_t i = 0; i < tracks.size(); i++)
+		{
+			CHECK(normalized_equal(result.at(i), tracks.at(i)));
+		}
+	}
+
+	SUBCASE("legacy format")
+	{
+		nlohmann::json json = tracks;
+		CHECK_FALSE(lib::normalized_tracks::is_normalized(json));
+
+		auto result = lib::normalized_tracks::from_json(json);
+		REQUIRE_EQ(result.size(), tracks.size());
+		CHECK(normalized_equal(result.at(3), tracks.at(3)));
+	}
+
+	SUBCASE("invalid")
+	{
+		CHECK(lib::normalized_tracks::from_json(nullptr).empty());
+		CHECK(lib::normalized_tracks::from_json(nlohmann::json::object()).empty());
+	}
+}
@@ -0,0 +1,111 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/playlistdelta.hpp"
+#include "testtracks.hpp"
+
+TEST_CASE("playlist_delta")
+{
+	lib::spt::playlist cached;
+	cached.id = "playlist";
+	cached.snapshot = "1";
+	cached.tracks = test_tracks::tracks({"a", "b", "c"});
+
+	lib::spt::playlist latest;
+	latest.id = "playlist";
+	latest.snapshot = "2";
+
+	SUBCASE("up to date")
+	{
+		latest.snapshot = "1";
+		latest.tracks_total = 3;
+
+		lib::spt::playlist_delta delta(cached, latest);
+		CHECK(delta.is_up_to_date());
+		CHECK_FALSE(delta.is_append());
+	}
+
+	SUBCASE("not cached")
+	{
+		latest.tracks_total = 3;
+
+		lib::spt::playlist_delta delta(lib::spt::playlist(), latest);
+		CHECK_FALSE(delta.is_up_to_date());
+		CHECK_FALSE(delta.is_append());
+	}
+
+	SUBCASE("appended")
+	{
+		latest.tracks_total = 5;
+
+		lib::spt::playlist_delta delta(cached, latest);
+		REQUIRE(delta.is_append());
+		CHECK_EQ(delta.offset(), 2);
+
+		REQUIRE_EQ(delta.checks().size(), 1);
+		CHECK_EQ(delta.checks().front(), std::make_pair(0, 2));
+
+		auto tracks = cached.tracks;
+		CHECK(delta.apply(test_tracks::tracks({"a", "b"}),
+			test_tracks::tracks({"c", "d", "e"}), tracks));
+		REQUIRE_EQ(tracks.size(), 5);
+		CHECK_EQ(tracks.at(3).id, "d");
+		CHECK_EQ(tracks.at(4).id, "e");
+	}
+
+	SUBCASE("changed before end")
+	{
+		latest.tracks_total = 5;
+
+		lib::spt::playlist_delta delta(cached, latest);
+		auto tracks = cached.tracks;
+		CHECK_FALSE(delta.apply(test_tracks::tracks({"a", "b"}),
+			test_tracks::tracks({"d", "e", "f"}), tracks));
+		CHECK_EQ(tracks.size(), 3);
+	}
+
+	SUBCASE("replaced and appended")
+	{
+		// a, x, c, d
+		latest.tracks_total = 4;
+
+		lib::spt::playlist_delta delta(cached, latest);
+		auto tracks = cached.tracks;
+		CHECK_FALSE(delta.apply(test_tracks::tracks({"a", "x"}),
+			test_tracks::tracks({"c", "d"}), tracks));
+		CHECK_EQ(tracks.size(), 3);
+	}
+
+	SUBCASE("removed and appended")
+	{
+		// b removed, then c and d appended: a, c, c, d
+		latest.tracks_total = 4;
+
+		lib::spt::playlist_delta delta(cached, latest);
+		auto tracks = cached.tracks;
+		CHECK_FALSE(delta.apply(test_tracks::tracks({"a", "c"}),
+			test_tracks::tracks({"c", "d"}), tracks));
+		CHECK_EQ(tracks.size(), 3);
+	}
+
+	SUBCASE("large playlist")
+	{
+		cached.tracks.resize(1001);
+		cached.tracks.back().id = "z";
+		latest.tracks_total = 1010;
+
+		lib::spt::playlist_delta delta(cached, latest);
+		const auto checks = delta.checks();
+		REQUIRE_EQ(checks.size(), 5);
+		CHECK_EQ(checks.at(0), std::make_pair(0, 100));
+		CHECK_EQ(checks.at(1), std::make_pair(280, 1));
+		CHECK_EQ(checks.at(4), std::make_pair(820, 1));
+	}
+
+	SUBCASE("removed")
+	{
+		latest.tracks_total = 2;
+
+		lib::spt::playlist_delta delta(cached, latest);
+		CHECK_FALSE(delta.is_up_to_date());
+		CHECK_FALSE(delta.is_append());
+	}
+}
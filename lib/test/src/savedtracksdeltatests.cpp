@@ -0,0 +1,116 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/savedtracksdelta.hpp"
+#include "testtracks.hpp"
+
+TEST_CASE("saved_tracks_delta")
+{
+	const auto cached = test_tracks::saved({
+		{"c", "2021-01-03T00:00:00Z"},
+		{"b", "2021-01-02T00:00:00Z"},
+		{"a", "2021-01-01T00:00:00Z"},
+	});
+
+	SUBCASE("nothing new")
+	{
+		lib::spt::saved_tracks_delta delta(cached);
+		CHECK_FALSE(delta.add(cached));
+
+		auto tracks = cached;
+		CHECK(delta.apply(3, tracks));
+		CHECK_EQ(tracks.size(), 3);
+		CHECK(delta.added().empty());
+	}
+
+	SUBCASE("new tracks in first page")
+	{
+		lib::spt::saved_tracks_delta delta(cached);
+		CHECK_FALSE(delta.add(test_tracks::saved({
+			{"e", "2021-01-05T00:00:00Z"},
+			{"d", "2021-01-04T00:00:00Z"},
+			{"c", "2021-01-03T00:00:00Z"},
+		})));
+
+		auto tracks = cached;
+		REQUIRE(delta.apply(5, tracks));
+		REQUIRE_EQ(tracks.size(), 5);
+		CHECK_EQ(tracks.at(0).id, "e");
+		CHECK_EQ(tracks.at(2).id, "c");
+		CHECK_EQ(tracks.at(4).id, "a");
+	}
+
+	SUBCASE("new tracks in several pages")
+	{
+		lib::spt::saved_tracks_delta delta(cached);
+		CHECK(delta.add(test_tracks::saved({
+			{"f", "2021-01-06T00:00:00Z"},
+			{"e", "2021-01-05T00:00:00Z"},
+		})));
+		CHECK_FALSE(delta.add(test_tracks::saved({
+			{"d", "2021-01-04T00:00:00Z"},
+			{"c", "2021-01-03T00:00:00Z"},
+		})));
+
+		auto tracks = cached;
+		CHECK(delta.apply(6, tracks));
+		CHECK_EQ(delta.added().size(), 3);
+	}
+
+	SUBCASE("saved at same time as newest cached")
+	{
+		lib::spt::saved_tracks_delta delta(cached);
+		CHECK_FALSE(delta.add(test_tracks::saved({
+			{"d", "2021-01-03T00:00:00Z"},
+			{"c", "2021-01-03T00:00:00Z"},
+		})));
+		CHECK_EQ(delta.added().size(), 1);
+	}
+
+	SUBCASE("saved again")
+	{
+		lib::spt::saved_tracks_delta delta(cached);
+		delta.add(test_tracks::saved({
+			{"a", "2021-01-04T00:00:00Z"},
+			{"c", "2021-01-03T00:00:00Z"},
+		}));
+
+		auto tracks = cached;
+		REQUIRE(delta.apply(3, tracks));
+		CHECK_EQ(tracks.at(0).id, "a");
+		CHECK_EQ(tracks.at(2).id, "b");
+	}
+
+	SUBCASE("removed tracks")
+	{
+		lib::spt::saved_tracks_delta delta(cached);
+		delta.add(test_tracks::saved({
+			{"d", "2021-01-04T00:00:00Z"},
+			{"c", "2021-01-03T00:00:00Z"},
+		}));
+
+		auto tracks = cached;
+		CHECK_FALSE(delta.apply(3, tracks));
+		CHECK_EQ(tracks.size(), 3);
+		CHECK_EQ(tracks.at(0).id, "c");
+	}
+
+	SUBCASE("Spotify IDs")
+	{
+		const auto spotify_cached = test_tracks::saved({
+			{"4uLU6hMCjMI75M1A2tKUQC", "2021-01-02T00:00:00Z"},
+			{"00000000000lYGhA16ahyg", "2021-01-02T00:00:00Z"},
+			{"6rqhFgbbKwnb9MLmUQDhG6", "2021-01-01T00:00:00Z"},
+		});
+
+		lib::spt::saved_tracks_delta delta(spotify_cached);
+		CHECK_FALSE(delta.add(test_tracks::saved({
+			{"6rqhFgbbKwnb9MLmUQDhG6", "2021-01-03T00:00:00Z"},
+			{"00000000000lYGhA16ahyg", "2021-01-02T00:00:00Z"},
+		})));
+		CHECK_EQ(delta.added().size(), 1);
+
+		auto tracks = spotify_cached;
+		REQUIRE(delta.apply(3, tracks));
+		CHECK_EQ(tracks.at(0).id, "6rqhFgbbKwnb9MLmUQDhG6");
+		CHECK_EQ(tracks.at(2).id, "00000000000lYGhA16ahyg");
+	}
+}
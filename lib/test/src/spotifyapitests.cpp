@@ -1,5 +1,62 @@
 #include "thirdparty/doctest.h"
 #include "lib/spotify/api.hpp"
+#include "lib/paths/paths.hpp"
+
+class api_test_paths: public lib::paths
+{
+public:
+	auto config_file() const -> ghc::filesystem::path override
+	{
+		return "spotify-qt-api-test.json";
+	}
+
+	auto cache() const -> ghc::filesystem::path override
+	{
+		return "cache";
+	}
+};
+
+/**
+ * Responds to GET requests from a fixed set of responses
+ */
+class api_test_http_client: public lib::http_client
+{
+public:
+	std::map<std::string, std::string> responses;
+	mutable int requests = 0;
+
+	void get(const std::string &url, const lib::headers &/*headers*/,
+		lib::callback<std::string> &callback) const override
+	{
+		requests++;
+		const auto response = responses.find(url);
+		callback(response == responses.end() ? std::string() : response->second);
+	}
+
+	void put(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &callback) const override
+	{
+		callback(std::string());
+	}
+
+	void post(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &callback) const override
+	{
+		callback(std::string());
+	}
+
+	auto post(const std::string &/*url*/, const lib::headers &/*headers*/,
+		const std::string &/*post_data*/) const -> std::string override
+	{
+		return std::string();
+	}
+
+	void del(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &callback) const override
+	{
+		callback(std::string());
+	}
+};
 
 TEST_CASE("spotify_api")
 {
@@ -21,4 +78,83 @@ TEST_CASE("spotify_api")
 		CHECK_EQ(lib::spt::api::to_id("4uLU6hMCjMI75M1A2tKUQC"),
 			"4uLU6hMCjMI75M1A2tKUQC");
 	}
+
+	SUBCASE("paged items")
+	{
+		lib::log::set_log_to_stdout(false);
+
+		api_test_paths paths;
+		lib::settings settings(paths);
+		settings.account.last_refresh = lib::date_time::seconds_since_epoch();
+
+		api_test_http_client http_client;
+		http_client.responses = {
+			{
+				"https://api.spotify.com/v1/albums/album/tracks?limit=50",
+				R"({"total": 3, "items": [{"id": "1", "name": "One"}, {"id": "2", "name": "Two"}],)"
+				R"( "next": "https://api.spotify.com/v1/albums/album/tracks?offset=2&limit=50"})",
+			},
+			{
+				"https://api.spotify.com/v1/albums/album/tracks?offset=2&limit=50",
+				R"({"total": 3, "items": [{"id": "3", "name": "Three"}], "next": null})",
+			},
+		};
+
+		lib::spt::api api(settings, http_client);
+		api.refresh(false);
+
+		lib::spt::album album;
+		album.id = "album";
+		album.name = "Album";
+
+		std::vector<lib::spt::track> tracks;
+		api.album_tracks(album, [&tracks](std::vector<lib::spt::track> &&result)
+		{
+			tracks = std::move(result);
+		});
+
+		CHECK_EQ(http_client.requests, 2);
+		REQUIRE_EQ(tracks.size(), 3);
+		CHECK_EQ(tracks.at(0).id, "1");
+		CHECK_EQ(tracks.at(1).id, "2");
+		CHECK_EQ(tracks.at(2).name, "Three");
+		CHECK_EQ(tracks.at(2).album.name, "Album");
+	}
+
+	SUBCASE("saved tracks page without next")
+	{
+		lib::log::set_log_to_stdout(false);
+
+		api_test_paths paths;
+		lib::settings settings(paths);
+		settings.account.last_refresh = lib::date_time::seconds_since_epoch();
+
+		api_test_http_client http_client;
+		http_client.responses = {
+			{
+				"https://api.spotify.com/v1/me/tracks?limit=50",
+				R"({"total": 2, "items": [{"added_at": "2021-02-01T00:00:00Z",)"
+				R"( "track": {"id": "2", "name": "Two"}}]})",
+			},
+		};
+
+		lib::spt::api api(settings, http_client);
+		api.refresh(false);
+
+		lib::spt::track cached_track;
+		cached_track.id = "1";
+		cached_track.name = "One";
+		cached_track.added_at = "2021-01-01T00:00:00Z";
+
+		std::vector<lib::spt::track> tracks;
+		api.saved_tracks({cached_track}, [&tracks](std::vector<lib::spt::track> &&result)
+		{
+			tracks = std::move(result);
+		});
+
+		CHECK_EQ(http_client.requests, 1);
+		REQUIRE_EQ(tracks.size(), 2);
+		CHECK_EQ(tracks.at(0).id, "2");
+		CHECK_EQ(tracks.at(1).id, "1");
+	}
 }
@@ -0,0 +1,83 @@
+#include "thirdparty/doctest.h"
+#include "lib/stringpool.hpp"
+
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("string_pool")
+{
+	lib::string_pool pool;
+
+	SUBCASE("intern")
+	{
+		const auto str1 = pool.intern("5VkSsvqlxoRVHdM6Iltkkd");
+		const auto str2 = pool.intern(std::string("5VkSsvqlxoRVHdM6Iltkkd"));
+		const auto str3 = pool.intern("3AJwUDP919kvQ9QcozQPxg");
+
+		CHECK(str1 == str2);
+		CHECK(&str1.str() == &str2.str());
+		CHECK(str1 != str3);
+		CHECK(str3 < str1);
+		CHECK(str1.str() == "5VkSsvqlxoRVHdM6Iltkkd");
+
+		const std::string &value = str3;
+		CHECK(value == "3AJwUDP919kvQ9QcozQPxg");
+
+		CHECK(pool.size() == 2);
+		CHECK(pool.bytes() == 44);
+	}
+
+	SUBCASE("empty")
+	{
+		CHECK(pool.intern(std::string()) == lib::interned_string());
+		CHECK(pool.intern(std::string()).empty());
+		CHECK(pool.size() == 0);
+	}
+
+	SUBCASE("hash")
+	{
+		std::unordered_map<lib::interned_string, int> counts;
+		counts[pool.intern("a")]++;
+		counts[pool.intern("b")]++;
+		counts[pool.intern("a")]++;
+
+		CHECK(counts.size() == 2);
+		CHECK(counts.at(pool.intern("a")) == 2);
+	}
+
+	SUBCASE("handles survive rehash and move")
+	{
+		const auto first = pool.intern("first");
+		for (auto i = 0; i < 10000; i++)
+		{
+			pool.intern(std::to_string(i));
+		}
+		CHECK(first.str() == "first");
+
+		lib::string_pool moved(std::move(pool));
+		CHECK(moved.intern("first") == first);
+		CHECK(moved.size() == 10001);
+	}
+
+	SUBCASE("threads")
+	{
+		std::vector<std::thread> threads;
+		for (auto i = 0; i < 4; i++)
+		{
+			threads.emplace_back([&pool]()
+			{
+				for (auto j = 0; j < 1000; j++)
+				{
+					pool.intern(std::to_string(j));
+				}
+			});
+		}
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		CHECK(pool.size() == 1000);
+	}
+}
@@ -212,6 +212,29 @@ TEST_CASE("strings::to_lower")
 	CHECK_EQ(lib::strings::to_lower(str), "aa,bb,cc");
 }
 
+TEST_CASE("strings::fold_case")
+{
+	SUBCASE("ascii")
+	{
+		CHECK_EQ(lib::strings::fold_case("aa,BB,Cc"), "aa,bb,cc");
+	}
+
+	SUBCASE("non-ascii")
+	{
+		CHECK_EQ(lib::strings::fold_case("ÉLAN Ærø"), "élan ærø");
+		CHECK_EQ(lib::strings::fold_case("ŁÓDŹ Ÿ"), "łódź ÿ");
+		CHECK_EQ(lib::strings::fold_case("ΣΟΦΟΣ σοφος"), "σοφοσ σοφοσ");
+		CHECK_EQ(lib::strings::fold_case("КИНО Ёж"), "кино ёж");
+		CHECK_EQ(lib::strings::fold_case("日本語 ＡＢＣ"), "日本語 ａｂｃ");
+	}
+
+	SUBCASE("invalid")
+	{
+		const std::string invalid("A\xc3\xff\xe6");
+		CHECK_EQ(lib::strings::fold_case(invalid), "a\xc3\xff\xe6");
+	}
+}
+
 TEST_CASE("strings::to_upper")
 {
 	std::string str("aa,BB,Cc");
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "lib/spotify/track.hpp"
+#include "lib/format.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Track fixtures shared between tests
+ */
+namespace test_tracks
+{
+	/**
+	 * Track with a name, album and artist, all based on id
+	 */
+	inline auto track(const std::string &id) -> lib::spt::track
+	{
+		lib::spt::track track;
+		track.id = id;
+		track.name = "Track " + id;
+		track.album.id = "album";
+		track.album.name = "Album";
+		track.duration = 180000;
+
+		lib::spt::entity artist;
+		artist.id = "artist";
+		artist.name = "Artist";
+		track.artists.push_back(artist);
+		return track;
+	}
+
+	/**
+	 * Tracks with specified ids, in order
+	 */
+	inline auto tracks(const std::vector<std::string> &ids) -> std::vector<lib::spt::track>
+	{
+		std::vector<lib::spt::track> tracks;
+		for (const auto &id : ids)
+		{
+			tracks.push_back(track(id));
+		}
+		return tracks;
+	}
+
+	/**
+	 * Tracks with ids track0, track1, ...
+	 */
+	inline auto tracks(int count) -> std::vector<lib::spt::track>
+	{
+		std::vector<lib::spt::track> tracks;
+		for (auto i = 0; i < count; i++)
+		{
+			tracks.push_back(track(lib::fmt::format("track{}", i)));
+		}
+		return tracks;
+	}
+
+	/**
+	 * Saved tracks, as id and when it was saved
+	 */
+	inline auto saved(const std::vector<std::pair<std::string, std::string>> &items)
+	-> std::vector<lib::spt::track>
+	{
+		std::vector<lib::spt::track> tracks;
+		for (const auto &item : items)
+		{
+			tracks.push_back(track(item.first));
+			tracks.back().added_at = item.second;
+		}
+		return tracks;
+	}
+
+	/**
+	 * Track where name is also used as id, for sorting and filtering by column
+	 */
+	inline auto named(const std::string &name, const std::string &artist,
+		const std::string &album, int duration = 0,
+		const std::string &added_at = std::string()) -> lib::spt::track
+	{
+		lib::spt::track track;
+		track.id = name;
+		track.name = name;
+		track.album.name = album;
+		track.duration = duration;
+		track.added_at = added_at;
+
+		lib::spt::entity entity;
+		entity.name = artist;
+		track.artists.push_back(entity);
+		return track;
+	}
+}
@@ -0,0 +1,58 @@
+#include "thirdparty/doctest.h"
+#include "lib/tracks/trackcolumns.hpp"
+#include "testtracks.hpp"
+
+TEST_CASE("track_columns")
+{
+	std::vector<lib::spt::track> tracks{
+		test_tracks::named("Bravo", "The Band", "Album The Band",
+			200000, "2021-01-02T00:00:00Z"),
+		test_tracks::named("alpha", "Artist", "Album Artist",
+			100000, "2021-01-03T00:00:00Z"),
+		test_tracks::named("Charlie", "artist", "Album artist",
+			300000, ""),
+		test_tracks::named("Delta", "Artist", "Album Artist",
+			100000, "2021-01-01T00:00:00Z"),
+	};
+	tracks.at(2).is_local = true;
+
+	const lib::track_columns columns(tracks);
+
+	SUBCASE("columns")
+	{
+		REQUIRE(columns.size() == 4);
+		CHECK(columns.name(1) == "alpha");
+		CHECK(columns.artist(0) == "The Band");
+		CHECK(columns.album(0) == "Album The Band");
+		CHECK(columns.duration(2) == 300000);
+		CHECK(columns.added_at(0) == 1609545600);
+		CHECK(columns.added_at(2) == 0);
+		CHECK(columns.is_local(2));
+		CHECK_FALSE(columns.is_local(0));
+		CHECK(columns.is_playable(0));
+	}
+
+	SUBCASE("sort")
+	{
+		using rows = std::vector<size_t>;
+
+		CHECK(columns.sort(lib::track_column::index, true) == rows{0, 1, 2, 3});
+		CHECK(columns.sort(lib::track_column::index, false) == rows{3, 2, 1, 0});
+
+		// Case and "The " is ignored
+		CHECK(columns.sort(lib::track_column::title, true) == rows{1, 0, 2, 3});
+		CHECK(columns.sort(lib::track_column::artist, true) == rows{1, 2, 3, 0});
+
+		// Equal rows keep order
+		CHECK(columns.sort(lib::track_column::length, true) == rows{1, 3, 0, 2});
+		CHECK(columns.sort(lib::track_column::length, false) == rows{2, 0, 1, 3});
+
+		CHECK(columns.sort(lib::track_column::added, true) == rows{2, 3, 0, 1});
+	}
+
+	SUBCASE("statistics")
+	{
+		CHECK(columns.total_duration() == 700000);
+		CHECK(columns.playable_count() == 3);
+	}
+}
@@ -0,0 +1,67 @@
+#include "thirdparty/doctest.h"
+#include "lib/tracks/trackdiff.hpp"
+#include "lib/listdiff.hpp"
+#include "testtracks.hpp"
+
+TEST_CASE("track_diff")
+{
+	const std::vector<lib::spt::track> previous{
+		test_tracks::track("a"),
+		test_tracks::track("b"),
+		test_tracks::track("a"),
+		test_tracks::track("c"),
+	};
+
+	SUBCASE("same tracks")
+	{
+		const lib::track_diff diff(previous, previous);
+		CHECK(diff.empty());
+		CHECK_FALSE(diff.has_changed_tracks());
+		CHECK(diff.next_indices() == std::vector<size_t>{0, 1, 2, 3});
+	}
+
+	SUBCASE("duplicates match by position")
+	{
+		const std::vector<lib::spt::track> next{
+			test_tracks::track("a"),
+			test_tracks::track("c"),
+			test_tracks::track("a"),
+		};
+
+		const lib::track_diff diff(previous, next);
+		CHECK_FALSE(diff.empty());
+		CHECK(diff.next_indices() == std::vector<size_t>{0, lib::track_diff::npos, 2, 1});
+
+		// Removed tracks get keys not in next
+		CHECK(diff.keys({3, 1, 0}) == std::vector<size_t>{1, 4, 0});
+
+		const lib::list_diff changes(diff.keys({0, 1, 2, 3}), {0, 1, 2});
+		CHECK(changes.changes().size() == 2);
+	}
+
+	SUBCASE("changed details")
+	{
+		auto next = previous;
+		next.at(1).added_at = "2021-01-01T00:00:00Z";
+
+		const lib::track_diff diff(previous, next);
+		CHECK_FALSE(diff.empty());
+		CHECK(diff.has_changed_tracks());
+		CHECK(diff.next_indices() == std::vector<size_t>{0, 1, 2, 3});
+	}
+
+	SUBCASE("local tracks match by name")
+	{
+		auto local = test_tracks::track(std::string());
+		local.name = "Local";
+		local.is_local = true;
+
+		auto next = previous;
+		next.insert(next.begin(), local);
+		auto with_local = previous;
+		with_local.push_back(local);
+
+		const lib::track_diff diff(with_local, next);
+		CHECK(diff.next_indices() == std::vector<size_t>{1, 2, 3, 4, 0});
+	}
+}
@@ -0,0 +1,63 @@
+#include "thirdparty/doctest.h"
+#include "lib/tracks/trackfilter.hpp"
+#include "testtracks.hpp"
+
+TEST_CASE("track_filter")
+{
+	const lib::track_columns columns(std::vector<lib::spt::track>{
+		test_tracks::named("Blue Monday", "New Order", "Substance"),
+		test_tracks::named("Ceremony", "New Order", "Movement"),
+		test_tracks::named("Blue Hotel", "Chris Isaak", "Heart Shaped World"),
+		test_tracks::named("Monday Morning", "Fleetwood Mac", "Fleetwood Mac"),
+	});
+
+	lib::track_filter filter(columns);
+
+	SUBCASE("empty query")
+	{
+		CHECK(filter.size() == 4);
+		CHECK(filter.filter(std::string()) == std::vector<size_t>{0, 1, 2, 3});
+		CHECK(lib::track_filter().filter("blue").empty());
+	}
+
+	SUBCASE("title, artist or album, ignoring case")
+	{
+		CHECK(filter.filter("BLUE") == std::vector<size_t>{0, 2});
+		CHECK(filter.filter("order") == std::vector<size_t>{0, 1});
+		CHECK(filter.filter("movement") == std::vector<size_t>{1});
+		CHECK(filter.filter("nothing").empty());
+	}
+
+	SUBCASE("growing query")
+	{
+		CHECK(filter.filter("m") == std::vector<size_t>{0, 1, 3});
+		CHECK(filter.filter("mon") == std::vector<size_t>{0, 1, 3});
+		CHECK(filter.filter("mond") == std::vector<size_t>{0, 3});
+		CHECK(filter.filter("monday m") == std::vector<size_t>{3});
+		CHECK(filter.filter("blue monday m").empty());
+	}
+
+	SUBCASE("shrinking query")
+	{
+		CHECK(filter.filter("monday m") == std::vector<size_t>{3});
+		CHECK(filter.filter("monday") == std::vector<size_t>{0, 3});
+		CHECK(filter.filter("blue") == std::vector<size_t>{0, 2});
+		CHECK(filter.filter("blu") == std::vector<size_t>{0, 2});
+		CHECK(filter.filter("ue ho") == std::vector<size_t>{2});
+	}
+
+	SUBCASE("ignores case of non-ascii letters")
+	{
+		lib::track_filter unicode(lib::track_columns(std::vector<lib::spt::track>{
+			test_tracks::named("Élan", "Mötley Crüe", "Dr. Feelgood"),
+			test_tracks::named("Кино", "ÆØÅ", "Ñu"),
+		}));
+
+		CHECK(unicode.filter("élan") == std::vector<size_t>{0});
+		CHECK(unicode.filter("ÉLAN") == std::vector<size_t>{0});
+		CHECK(unicode.filter("CRÜE") == std::vector<size_t>{0});
+		CHECK(unicode.filter("кино") == std::vector<size_t>{1});
+		CHECK(unicode.filter("æøå") == std::vector<size_t>{1});
+		CHECK(unicode.filter("ñ") == std::vector<size_t>{1});
+	}
+}
@@ -0,0 +1,71 @@
+#include "thirdparty/doctest.h"
+#include "lib/tracks/tracksortkeys.hpp"
+#include "testtracks.hpp"
+
+TEST_CASE("track_sort_keys")
+{
+	const lib::track_columns columns(std::vector<lib::spt::track>{
+		test_tracks::named("Bravo", "The Band", "The Band", 200000),
+		test_tracks::named("alpha", "artist", "artist", 100000),
+		test_tracks::named("Charlie", "Artist", "Artist", 300000),
+		test_tracks::named("ALPHA", "band", "band", 100000),
+	});
+
+	const lib::track_sort_keys keys(columns);
+
+	SUBCASE("size")
+	{
+		CHECK(keys.size() == 4);
+		CHECK(lib::track_sort_keys().size() == 0);
+		CHECK(lib::track_sort_keys().sort(lib::track_column::title, true).empty());
+	}
+
+	SUBCASE("text ignores case and leading the")
+	{
+		CHECK(keys.sort(lib::track_column::title, true) == std::vector<size_t>{1, 3, 0, 2});
+		CHECK(keys.sort(lib::track_column::artist, true) == std::vector<size_t>{1, 2, 0, 3});
+	}
+
+	SUBCASE("text ignores case of non-ascii letters")
+	{
+		const lib::track_columns unicode(std::vector<lib::spt::track>{
+			test_tracks::named("Élan", "Ärzte", "Ärzte"),
+			test_tracks::named("éclair", "ärzte", "ärzte"),
+			test_tracks::named("Ñu", "Öl", "Öl"),
+		});
+
+		const lib::track_sort_keys unicode_keys(unicode);
+		CHECK(unicode_keys.sort(lib::track_column::title, true) == std::vector<size_t>{1, 0, 2});
+		CHECK(unicode_keys.sort(lib::track_column::artist, false) == std::vector<size_t>{2, 0, 1});
+	}
+
+	SUBCASE("descending keeps equal rows in order")
+	{
+		CHECK(keys.sort(lib::track_column::title, false) == std::vector<size_t>{2, 0, 1, 3});
+		CHECK(keys.sort(lib::track_column::length, false) == std::vector<size_t>{2, 0, 1, 3});
+	}
+
+	SUBCASE("one column")
+	{
+		const lib::track_sort_keys length(columns, lib::track_column::length);
+		CHECK(length.sort(lib::track_column::length, true) == std::vector<size_t>{1, 3, 0, 2});
+		CHECK(length.sort(lib::track_column::index, false) == std::vector<size_t>{3, 2, 1, 0});
+		CHECK_THROWS_AS(length.sort(lib::track_column::title, true), std::invalid_argument);
+	}
+
+	SUBCASE("same order as track columns")
+	{
+		for (const auto column: {
+			lib::track_column::index,
+			lib::track_column::title,
+			lib::track_column::artist,
+			lib::track_column::album,
+			lib::track_column::length,
+			lib::track_column::added,
+		})
+		{
+			CHECK(keys.sort(column, true) == columns.sort(column, true));
+			CHECK(keys.sort(column, false) == columns.sort(column, false));
+		}
+	}
+}
@@ -10,7 +10,10 @@ TracksCacheDialog::TracksCacheDialog(lib::cache &cache, QWidget *parent)
 	auto *layout = new QVBoxLayout(this);
 	setLayout(layout);
 
-	tree = new QTreeWidget(this);
+	model = new TracksCacheModel(this);
+
+	tree = new QTreeView(this);
+	tree->setModel(model);
 	layout->addWidget(tree);
 
 	tree->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -18,10 +21,7 @@ TracksCacheDialog::TracksCacheDialog(lib::cache &cache, QWidget *parent)
 	tree->setSortingEnabled(true);
 	tree->setRootIsDecorated(false);
 	tree->setAllColumnsShowFocus(true);
-	tree->setColumnCount(3);
-	tree->setHeaderLabels({
-		"Title", "Artist", "Album",
-	});
+	tree->setUniformRowHeights(true);
 
 	auto *buttons = new QDialogButtonBox(this);
 	layout->addWidget(buttons);
@@ -36,19 +36,10 @@ void TracksCacheDialog::okClicked(bool /*checked*/)
 
 void TracksCacheDialog::open()
 {
-	tree->clear();
-
-	for (const auto &pair : cache.all_tracks())
-	{
-		for (const auto &track : pair.second)
-		{
-			new QTreeWidgetItem(tree, {
-				QString::fromStdString(track.name),
-				QString::fromStdString(lib::spt::entity::combine_names(track.artists)),
-				QString::fromStdString(track.album.name),
-			});
-		}
-	}
+	// Rows are only created as they're shown
+	model->load(cache);
+	tree->sortByColumn(tree->header()->sortIndicatorSection(),
+		tree->header()->sortIndicatorOrder());
 
 	QDialog::open();
 }
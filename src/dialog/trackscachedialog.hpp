@@ -2,9 +2,11 @@
 
 #include "lib/qtpaths.hpp"
 #include "lib/cache.hpp"
+#include "model/trackscachemodel.hpp"
 
 #include <QDialog>
-#include <QTreeWidget>
+#include <QTreeView>
+#include <QHeaderView>
 #include <QVBoxLayout>
 #include <QDialogButtonBox>
 #include <QPushButton>
@@ -17,7 +19,8 @@ public:
 	explicit TracksCacheDialog(lib::cache &cache, QWidget *parent);
 
 private:
-	QTreeWidget *tree = nullptr;
+	QTreeView *tree = nullptr;
+	TracksCacheModel *model = nullptr;
 	lib::cache &cache;
 
 	void okClicked(bool checked);
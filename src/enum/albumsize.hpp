@@ -0,0 +1,22 @@
+#pragma once
+
+/**
+ * Pre-scaled album image sizes, in pixels
+ */
+enum class AlbumSize: int
+{
+	/**
+	 * Icon in a list or tree
+	 */
+	List = 32,
+
+	/**
+	 * Album in the context view
+	 */
+	Context = 64,
+
+	/**
+	 * Album as tray icon
+	 */
+	Tray = 128,
+};
@@ -10,4 +10,5 @@ enum DataRole
 	RoleAddedDate = 0x105,    // 261
 	RoleLength = 0x106,       // 262
 	RoleDefaultIndex = 0x107, // 263
+	RoleHistoryMonth = 0x108, // 264
 };
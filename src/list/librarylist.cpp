@@ -1,12 +1,13 @@
 #include "librarylist.hpp"
 #include "mainwindow.hpp"
 
-LibraryList::LibraryList(spt::Spotify &spotify, QWidget *parent)
+LibraryList::LibraryList(spt::Spotify &spotify, lib::settings &settings, QWidget *parent)
 	: spotify(spotify),
+	settings(settings),
 	QTreeWidget(parent)
 {
 	addTopLevelItems({
-		TreeUtils::itemWithNoChildren(this, recentlyPlayed,
+		TreeUtils::itemWithEmptyChild(this, recentlyPlayed,
 			"Most recently played tracks from any device"),
 		TreeUtils::itemWithNoChildren(this, savedTracks,
 			"Liked and saved tracks"),
@@ -37,7 +38,8 @@ void LibraryList::clicked(QTreeWidgetItem *item, int /*column*/)
 {
 	if (item != nullptr
 		&& item->parent() == nullptr
-		&& item->childCount() > 0)
+		&& item->childCount() > 0
+		&& item->text(0) != recentlyPlayed)
 	{
 		item->setExpanded(true);
 		return;
@@ -62,6 +64,10 @@ void LibraryList::clicked(QTreeWidgetItem *item, int /*column*/)
 			case RoleAlbumId:
 				mainWindow->loadAlbum(data);
 				break;
+
+			case RoleHistoryMonth:
+				historyMonthClicked(item->data(0, 0x100).toInt());
+				break;
 		}
 	}
 	else
@@ -79,18 +85,37 @@ void LibraryList::clicked(QTreeWidgetItem *item, int /*column*/)
 			songs->load(cacheTracks);
 		}
 
-		auto callback = [this, id](const std::vector<lib::spt::track> &tracks)
+		auto callback = [this, id](std::vector<lib::spt::track> tracks)
 		{
-			this->tracksLoaded(id, tracks);
+			this->tracksLoaded(id, std::move(tracks));
 		};
 
 		if (item->text(0) == recentlyPlayed)
 		{
-			spotify.recently_played(callback);
+			syncHistory([mainWindow, callback]()
+			{
+				const auto &history = mainWindow->getHistory();
+				callback(historyTracks(history.before(lib::date_time::seconds_since_epoch() + 1,
+					historyCount)));
+			});
 		}
 		else if (item->text(0) == savedTracks)
 		{
-			spotify.saved_tracks(callback);
+			// Occasionally fetch everything, to also find removed tracks
+			const auto now = lib::date_time::seconds_since_epoch();
+			if (now - settings.general.last_saved_tracks_sync >= fullSyncAge)
+			{
+				spotify.saved_tracks([this, now, callback](std::vector<lib::spt::track> tracks)
+				{
+					settings.general.last_saved_tracks_sync = now;
+					settings.save();
+					callback(std::move(tracks));
+				});
+			}
+			else
+			{
+				spotify.saved_tracks(cacheTracks, callback);
+			}
 		}
 		else if (item->text(0) == topTracks)
 		{
@@ -109,17 +134,13 @@ void LibraryList::clicked(QTreeWidgetItem *item, int /*column*/)
 					if (all.find(album.artist) != all.end())
 					{
 						spotify.album_tracks(album,
-							[album, callback](const std::vector<lib::spt::track> &results)
+							[album, callback](std::vector<lib::spt::track> &&tracks)
 							{
-								std::vector<lib::spt::track> tracks;
-								tracks.reserve(results.size());
-								for (const auto &result : results)
+								for (auto &track : tracks)
 								{
-									lib::spt::track track = result;
 									track.added_at = album.release_date;
-									tracks.push_back(track);
 								}
-								callback(tracks);
+								callback(std::move(tracks));
 							});
 						return;
 					}
@@ -130,19 +151,120 @@ void LibraryList::clicked(QTreeWidgetItem *item, int /*column*/)
 	}
 }
 
-void LibraryList::tracksLoaded(const std::string &id, const std::vector<lib::spt::track> &tracks)
+void LibraryList::tracksLoaded(const std::string &id, std::vector<lib::spt::track> tracks)
 {
 	auto *mainWindow = MainWindow::find(parentWidget());
 
 	if (!tracks.empty())
 	{
 		mainWindow->saveTracksToCache(id, tracks);
-		mainWindow->getSongsTree()->load(tracks);
+		mainWindow->getSongsTree()->update(std::move(tracks), std::string());
 		mainWindow->setNoSptContext();
 	}
 	mainWindow->getSongsTree()->setEnabled(true);
 }
 
+void LibraryList::syncHistory(const std::function<void()> &callback)
+{
+	auto *mainWindow = MainWindow::find(parentWidget());
+	if (mainWindow == nullptr)
+	{
+		return;
+	}
+
+	auto loaded = [mainWindow, callback](const std::vector<lib::spt::track> &tracks)
+	{
+		auto &history = mainWindow->getHistory();
+		for (const auto &track : tracks)
+		{
+			// Spotify only returns when tracks were played as added date
+			const auto playedAt = lib::date_time::parse(track.added_at)
+				.to_seconds_since_epoch();
+
+			if (playedAt > 0)
+			{
+				history.add(track, playedAt, lib::play_source::finished);
+			}
+		}
+		callback();
+	};
+
+	// Only fetch plays newer than what we already have
+	const auto newest = mainWindow->getHistory().newest();
+	if (newest > 0)
+	{
+		spotify.recently_played(newest * 1000, loaded);
+	}
+	else
+	{
+		spotify.recently_played(loaded);
+	}
+}
+
+void LibraryList::historyMonthsLoaded(QTreeWidgetItem *item)
+{
+	auto *mainWindow = MainWindow::find(parentWidget());
+	if (mainWindow == nullptr)
+	{
+		return;
+	}
+
+	const auto months = mainWindow->getHistory().months();
+	if (months.empty())
+	{
+		auto *child = new QTreeWidgetItem(item, {
+			"No history"
+		});
+		child->setDisabled(true);
+		child->setToolTip(0, "Tracks played while spotify-qt is running are saved here");
+		item->addChild(child);
+		return;
+	}
+
+	// Already newest first, so don't sort
+	for (const auto &month : months)
+	{
+		const auto date = lib::date_time(month / 100, month % 100, 1, 0, 0, 0);
+		auto *child = new QTreeWidgetItem(item, {
+			QString::fromStdString(date.to_iso_date().substr(0, 7))
+		});
+		child->setData(0, 0x100, month);
+		child->setData(0, 0x101, RoleHistoryMonth);
+		item->addChild(child);
+	}
+}
+
+void LibraryList::historyMonthClicked(int key)
+{
+	auto *mainWindow = MainWindow::find(parentWidget());
+	if (mainWindow == nullptr)
+	{
+		return;
+	}
+
+	const auto tracks = historyTracks(mainWindow->getHistory().month(key));
+	mainWindow->getSongsTree()->load(tracks);
+	mainWindow->getSongsTree()->setEnabled(true);
+	mainWindow->setNoSptContext();
+}
+
+auto LibraryList::historyTracks(const std::vector<lib::history_play> &plays)
+-> std::vector<lib::spt::track>
+{
+	std::vector<lib::spt::track> tracks;
+	tracks.reserve(plays.size());
+
+	for (const auto &play : plays)
+	{
+		lib::spt::track track = play.track;
+		track.added_at = lib::date_time::from_seconds_since_epoch(play.played_at)
+			.to_iso_date_time();
+		tracks.push_back(track);
+	}
+
+	return tracks;
+}
+
 void LibraryList::doubleClicked(QTreeWidgetItem *item, int /*column*/)
 {
 	auto *mainWindow = MainWindow::find(parentWidget());
@@ -198,7 +320,14 @@ void LibraryList::expanded(QTreeWidgetItem *item)
 {
 	item->takeChildren();
 
-	if (item->text(0) == topArtists)
+	if (item->text(0) == recentlyPlayed)
+	{
+		syncHistory([this, item]()
+		{
+			this->historyMonthsLoaded(item);
+		});
+	}
+	else if (item->text(0) == topArtists)
 	{
 		spotify.top_artists([item](const std::vector<lib::spt::artist> &artists)
 		{
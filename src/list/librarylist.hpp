@@ -3,6 +3,8 @@
 #include "spotify/spotify.hpp"
 #include "util/treeutils.hpp"
 #include "listitem/library.hpp"
+#include "lib/history/historyplay.hpp"
+#include "lib/settings.hpp"
 
 #include <QTreeWidget>
 #include <QHeaderView>
@@ -12,10 +14,22 @@ class LibraryList: public QTreeWidget
 Q_OBJECT
 
 public:
-	LibraryList(spt::Spotify &spotify, QWidget *parent);
+	LibraryList(spt::Spotify &spotify, lib::settings &settings, QWidget *parent);
 
 private:
 	spt::Spotify &spotify;
+	lib::settings &settings;
+
+	/**
+	 * Fetch all liked tracks, instead of only new ones, if not done
+	 * for this many seconds
+	 */
+	static constexpr long fullSyncAge = 24 * 60 * 60;
+
+	/**
+	 * Maximum number of plays to show from local history
+	 */
+	static constexpr size_t historyCount = 1000;
 
 	static constexpr const char *followedArtists = "Followed Artists";
 	static constexpr const char *newReleases = "New Releases";
@@ -29,6 +43,16 @@ private:
 	void doubleClicked(QTreeWidgetItem *item, int column);
 	void expanded(QTreeWidgetItem *item);
 
-	void tracksLoaded(const std::string &id, const std::vector<lib::spt::track> &tracks);
+	void tracksLoaded(const std::string &id, std::vector<lib::spt::track> tracks);
+
+	/**
+	 * Add plays since last time to local history
+	 */
+	void syncHistory(const std::function<void()> &callback);
+	void historyMonthsLoaded(QTreeWidgetItem *item);
+	void historyMonthClicked(int key);
+
+	static auto historyTracks(const std::vector<lib::history_play> &plays)
+		-> std::vector<lib::spt::track>;
 	static void itemsLoaded(std::vector<ListItem::Library> &items, QTreeWidgetItem *item);
 };
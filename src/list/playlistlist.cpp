@@ -24,8 +24,8 @@ PlaylistList::PlaylistList(lib::spt::api &spotify, lib::settings &settings, lib:
 
 void PlaylistList::showEvent(QShowEvent */*event*/)
 {
-	// Playlists are already loaded, don't load from cache
-	if (count() > 0)
+	// Playlists are already loaded, or being loaded, don't load from cache
+	if (count() > 0 || cacheLoading)
 	{
 		return;
 	}
@@ -39,6 +39,11 @@ void PlaylistList::showEvent(QShowEvent */*event*/)
 	refresh();
 }
 
+void PlaylistList::setCacheLoading(bool value)
+{
+	cacheLoading = value;
+}
+
 auto PlaylistList::getItemIndex(QListWidgetItem *item) -> int
 {
 	return item == nullptr
@@ -85,8 +90,10 @@ void PlaylistList::menu(const QPoint &pos)
 	menu->popup(mapToGlobal(pos));
 }
 
-void PlaylistList::load(const std::vector<lib::spt::playlist> &playlists)
+void PlaylistList::load(const std::vector<lib::spt::playlist> &items)
 {
+	playlists = items;
+
 	QListWidgetItem *activeItem = nullptr;
 	const lib::spt::playlist *activePlaylist = nullptr;
 
@@ -287,14 +294,23 @@ auto PlaylistList::at(int index) -> lib::spt::playlist
 		return {};
 	}
 
-	return at(i->data(RolePlaylistId).toString().toStdString());
+	// Index playlist was loaded at, regardless of current order
+	const auto defaultIndex = i->data(RoleDefaultIndex).toInt();
+	if (defaultIndex < 0 || static_cast<size_t>(defaultIndex) >= playlists.size())
+	{
+		return {};
+	}
+
+	return playlists.at(defaultIndex);
 }
 
 auto PlaylistList::at(const std::string &id) -> lib::spt::playlist
 {
-	for (const auto &playlist : cache.get_playlists())
+	// ID or URI
+	const auto playlistId = lib::spt::api::to_id(id);
+	for (const auto &playlist : playlists)
 	{
-		if (lib::strings::ends_with(id, playlist.id))
+		if (playlist.id == playlistId)
 		{
 			return playlist;
 		}
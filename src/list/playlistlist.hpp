@@ -21,6 +21,12 @@ public:
 
 	auto allArtists() -> std::unordered_set<std::string>;
 
+	/**
+	 * Playlists are being loaded from cache, and refreshed when done,
+	 * so nothing needs to be loaded when shown
+	 */
+	void setCacheLoading(bool value);
+
 	auto at(int index) -> lib::spt::playlist;
 	auto at(const std::string &id) -> lib::spt::playlist;
 
@@ -32,6 +38,13 @@ private:
 	lib::cache &cache;
 	lib::settings &settings;
 
+	/**
+	 * Playlists as last loaded, in default order
+	 */
+	std::vector<lib::spt::playlist> playlists;
+
+	bool cacheLoading = false;
+
 	auto getItemIndex(QListWidgetItem *item) -> int;
 	void clicked(QListWidgetItem *item);
 	void doubleClicked(QListWidgetItem *item);
@@ -1,32 +1,27 @@
 #include "trackslist.hpp"
 
 #include "../mainwindow.hpp"
+#include "util/menuutils.hpp"
 
 TracksList::TracksList(spt::Spotify &spotify, lib::settings &settings, lib::cache &cache,
 	QWidget *parent)
 	: spotify(spotify),
 	settings(settings),
 	cache(cache),
-	QTreeWidget(parent)
+	QTreeView(parent)
 {
-	constexpr int emptyPixmapSize = 64;
-	constexpr int columnCount = 5;
-
-	// Empty icon used as replacement for play icon
-	QPixmap emptyPixmap(emptyPixmapSize, emptyPixmapSize);
-	emptyPixmap.fill(Qt::transparent);
-	emptyIcon = QIcon(emptyPixmap);
+	trackListModel = new TrackListModel(settings, this);
+	setModel(trackListModel);
 
 	setEditTriggers(QAbstractItemView::NoEditTriggers);
 	setSelectionBehavior(QAbstractItemView::SelectRows);
 	setSortingEnabled(true);
 	setRootIsDecorated(false);
 	setAllColumnsShowFocus(true);
-	setColumnCount(columnCount);
-	setHeaderLabels({
-		settings.general.track_numbers == lib::context_all ? "#" : "",
-		"Title", "Artist", "Album", "Length", "Added"
-	});
+
+	// All rows are the same height, so only rows in view need to be measured
+	setUniformRowHeights(true);
+
 	header()->setSectionsMovable(false);
 	header()->setSortIndicator(settings.general.song_header_sort_by + 1, Qt::AscendingOrder);
 
@@ -39,7 +34,7 @@ TracksList::TracksList(spt::Spotify &spotify, lib::settings &settings, lib::cach
 	}
 
 	// Play tracks on click or enter/special key
-	QTreeWidget::connect(this, &QTreeWidget::itemActivated, this, &TracksList::clicked);
+	QAbstractItemView::connect(this, &QAbstractItemView::activated, this, &TracksList::clicked);
 
 	// Song context menu
 	setContextMenuPolicy(Qt::ContextMenuPolicy::CustomContextMenu);
@@ -48,54 +43,92 @@ TracksList::TracksList(spt::Spotify &spotify, lib::settings &settings, lib::cach
 	// Songs header context menu
 	header()->setContextMenuPolicy(Qt::ContextMenuPolicy::CustomContextMenu);
 	QLabel::connect(header(), &QWidget::customContextMenuRequested, this, &TracksList::headerMenu);
+
+	// Filter bar, shown when typing in list
+	filterBar = new QLineEdit(this);
+	filterBar->setPlaceholderText("Filter tracks");
+	filterBar->setClearButtonEnabled(true);
+	filterBar->hide();
+
+	QLineEdit::connect(filterBar, &QLineEdit::textChanged, [this](const QString &text)
+	{
+		trackListModel->setFilter(text);
+	});
+
+	// Move to first match when pressing enter
+	QLineEdit::connect(filterBar, &QLineEdit::returnPressed, [this]()
+	{
+		setFocus();
+		if (!currentIndex().isValid())
+		{
+			setCurrentIndex(trackListModel->index(0, 0));
+		}
+	});
+
+	auto *closeFilterAction = new QAction(filterBar);
+	closeFilterAction->setShortcut(QKeySequence(Qt::Key_Escape));
+	closeFilterAction->setShortcutContext(Qt::WidgetShortcut);
+	filterBar->addAction(closeFilterAction);
+	QAction::connect(closeFilterAction, &QAction::triggered, this, &TracksList::closeFilter);
+
+	auto *filterAction = MenuUtils::createAction("edit-find", "Filter",
+		this, QKeySequence::Find);
+	filterAction->setShortcutContext(Qt::WidgetWithChildrenShortcut);
+	addAction(filterAction);
+	QAction::connect(filterAction, &QAction::triggered, [this]()
+	{
+		showFilter(QString());
+	});
 }
 
 void TracksList::menu(const QPoint &pos)
 {
-	auto *item = itemAt(pos);
-	if (item == nullptr)
-	{
-		return;
-	}
-
-	const auto &track = item->data(0, RoleTrack).value<lib::spt::track>();
-	if (!track.is_valid())
+	const auto index = indexAt(pos);
+	const auto *track = getTrack(index);
+	if (track == nullptr || !track->is_valid())
 	{
 		return;
 	}
 
-	auto index = item->data(0, RoleIndex).toInt();
-	auto *songMenu = new SongMenu(track, spotify, cache, index, parentWidget());
+	auto trackIndex = trackListModel->trackIndex(index);
+	auto *songMenu = new SongMenu(*track, spotify, cache, trackIndex, parentWidget());
 	songMenu->popup(mapToGlobal(pos));
 }
 
-void TracksList::clicked(QTreeWidgetItem *item, int /*column*/)
+void TracksList::clicked(const QModelIndex &index)
 {
-	if (item->isDisabled())
+	if (!index.flags().testFlag(Qt::ItemIsEnabled))
 	{
 		return;
 	}
 
 	auto *mainWindow = MainWindow::find(parentWidget());
 
-	bool indexFound;
-	auto trackIndex = item->data(0, RoleIndex).toInt(&indexFound);
-	if (!indexFound)
+	auto trackIndex = trackListModel->trackIndex(index);
+	if (trackIndex < 0)
 	{
 		mainWindow->setStatus("Failed to start playback: track not found", true);
 		return;
 	}
 
-	auto callback = [this, mainWindow, item](const std::string &status)
+	// Index is only valid for the tracks loaded when clicked
+	const auto tracks = trackListModel->getTracks();
+	const auto trackId = tracks->at(trackIndex).id;
+
+	auto callback = [this, mainWindow, tracks, trackIndex, trackId](const std::string &status)
 	{
 		if (!status.empty())
 		{
 			mainWindow->status(lib::fmt::format("Failed to start playback: {}",
 				status), true);
 		}
+		else if (this->trackListModel->getTracks() == tracks)
+		{
+			this->trackListModel->setPlayingIndex(trackIndex);
+		}
 		else
 		{
-			this->setPlayingTrackItem(item);
+			this->setPlayingTrackItem(trackId);
 		}
 
 		mainWindow->refresh();
@@ -104,8 +137,19 @@ void TracksList::clicked(QTreeWidgetItem *item, int /*column*/)
 	const auto &context = mainWindow->getSptContext();
 	if (context.empty())
 	{
+		// Invalid tracks aren't included, so row isn't always the offset
+		auto offset = 0;
+		for (auto row = 0; row < index.row(); row++)
+		{
+			const auto *track = getTrack(trackListModel->index(row, 0));
+			if (track != nullptr && track->is_valid())
+			{
+				offset++;
+			}
+		}
+
 		auto allTracks = mainWindow->currentTracks();
-		this->spotify.play_tracks(currentIndex().row(), allTracks, callback);
+		this->spotify.play_tracks(offset, allTracks, callback);
 	}
 	else
 	{
@@ -173,6 +217,8 @@ void TracksList::headerMenu(const QPoint &pos)
 
 void TracksList::resizeEvent(QResizeEvent *event)
 {
+	placeFilterBar();
+
 	if (settings.general.track_list_resize_mode != lib::resize_auto)
 	{
 		return;
@@ -181,6 +227,61 @@ void TracksList::resizeEvent(QResizeEvent *event)
 	resizeHeaders(event->size());
 }
 
+void TracksList::updateGeometries()
+{
+	QTreeView::updateGeometries();
+
+	// Header is placed in top margin, which is reset when updating
+	if (filterBar != nullptr && !filterBar->isHidden())
+	{
+		const auto margins = viewportMargins();
+		setViewportMargins(margins.left(), margins.top(), margins.right(),
+			filterBar->sizeHint().height());
+	}
+
+	placeFilterBar();
+}
+
+void TracksList::keyboardSearch(const QString &search)
+{
+	showFilter(search);
+}
+
+void TracksList::showFilter(const QString &text)
+{
+	if (filterBar->isHidden())
+	{
+		filterBar->show();
+		updateGeometries();
+	}
+
+	filterBar->setFocus();
+	if (!text.isEmpty())
+	{
+		filterBar->setText(filterBar->text() + text);
+	}
+}
+
+void TracksList::closeFilter()
+{
+	filterBar->clear();
+	filterBar->hide();
+	updateGeometries();
+	setFocus();
+}
+
+void TracksList::placeFilterBar()
+{
+	if (filterBar == nullptr || filterBar->isHidden())
+	{
+		return;
+	}
+
+	const auto &rect = viewport()->geometry();
+	filterBar->setGeometry(rect.left(), rect.bottom() + 1,
+		rect.width(), filterBar->sizeHint().height());
+}
+
 void TracksList::resizeHeaders(const QSize &newSize)
 {
 	constexpr int indexSize = 60;
@@ -233,75 +334,130 @@ void TracksList::updateResizeMode(lib::resize_mode mode)
 
 void TracksList::load(const std::vector<lib::spt::track> &tracks, const std::string &selectedId)
 {
-	clear();
-	trackItems.clear();
-	playingTrackItem = nullptr;
-	auto fieldWidth = static_cast<int>(std::to_string(tracks.size()).size());
-	auto current = getCurrent();
-	auto anyHasDate = false;
+	load(std::vector<lib::spt::track>(tracks), selectedId);
+}
 
-	setSortingEnabled(false);
+void TracksList::load(std::vector<lib::spt::track> &&tracks, const std::string &selectedId)
+{
+	// Rows only keep their index into this
+	trackListModel->load(std::make_shared<const std::vector<lib::spt::track>>(std::move(tracks)));
+	indexTracks();
+	selectTrack(selectedId);
+}
 
-	for (int i = 0; i < tracks.size(); i++)
+void TracksList::update(const std::vector<lib::spt::track> &tracks)
+{
+	update(std::vector<lib::spt::track>(tracks), std::string());
+}
+
+void TracksList::update(std::vector<lib::spt::track> &&tracks, const std::string &selectedId)
+{
+	if (trackListModel->update(std::make_shared<const std::vector<lib::spt::track>>(std::move(tracks))))
+	{
+		indexTracks();
+	}
+
+	if (!currentIndex().isValid())
 	{
-		const auto &track = tracks.at(i);
+		selectTrack(selectedId);
+	}
+}
+
+void TracksList::indexTracks()
+{
+	const auto &tracks = trackListModel->getTracks();
+	const auto trackCount = tracks ? static_cast<int>(tracks->size()) : 0;
+
+	trackIndexes.clear();
+	trackIndexes.reserve(trackCount);
+	const lib::spt::id currentId(getCurrent().playback.item.id);
+	auto playingIndex = -1;
+	auto anyHasDate = false;
 
-		auto *item = new ListItem::Track({
-			settings.general.track_numbers == lib::context_all
-				? QString("%1").arg(i + 1, fieldWidth)
-				: QString(),
-			QString::fromStdString(track.name),
-			QString::fromStdString(lib::spt::entity::combine_names(track.artists)),
-			QString::fromStdString(track.album.name),
-			QString::fromStdString(lib::fmt::time(track.duration)),
-			track.added_at.empty()
-				? QString()
-				: settings.general.relative_added
-				? DateUtils::toRelative(track.added_at)
-				: QLocale().toString(DateUtils::fromIso(track.added_at).date(),
-					QLocale::ShortFormat)
-		}, track, emptyIcon, i);
+	for (auto i = 0; i < trackCount; i++)
+	{
+		const auto &track = tracks->at(i);
 
 		if (!anyHasDate && !track.added_at.empty())
 		{
 			anyHasDate = true;
 		}
 
-		if (track.id == current.playback.item.id)
-		{
-			setPlayingTrackItem(item);
-		}
-
-		insertTopLevelItem(i, item);
-		trackItems[track.id] = item;
-
-		if (!selectedId.empty() && track.id == selectedId)
+		// Local tracks don't have an ID, so can't be looked up
+		const lib::spt::id trackId(track.id);
+		if (trackId.is_valid())
 		{
-			setCurrentItem(item);
+			trackIndexes[trackId] = i;
+			if (trackId == currentId)
+			{
+				playingIndex = i;
+			}
 		}
 	}
 
-	setSortingEnabled(true);
+	trackListModel->setPlayingIndex(playingIndex);
 
 	header()->setSectionHidden(static_cast<int>(Column::Added), !anyHasDate
 		|| lib::set::contains(settings.general.hidden_song_headers,
 			static_cast<int>(Column::Added)));
 }
 
+void TracksList::selectTrack(const std::string &trackId)
+{
+	const auto &tracks = trackListModel->getTracks();
+	if (trackId.empty() || !tracks)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < tracks->size(); i++)
+	{
+		if (tracks->at(i).id != trackId)
+		{
+			continue;
+		}
+
+		const auto selectedRow = trackListModel->row(static_cast<int>(i));
+		if (selectedRow >= 0)
+		{
+			setCurrentIndex(trackListModel->index(selectedRow, 0));
+		}
+		return;
+	}
+}
+
 void TracksList::load(const std::vector<lib::spt::track> &tracks)
 {
 	load(tracks, std::string());
 }
 
+auto TracksList::getTracks() const -> std::shared_ptr<const std::vector<lib::spt::track>>
+{
+	return trackListModel->getTracks();
+}
+
+auto TracksList::getTrack(const QModelIndex &index) const -> const lib::spt::track *
+{
+	const auto &tracks = trackListModel->getTracks();
+	const auto trackIndex = trackListModel->trackIndex(index);
+	if (!tracks || trackIndex < 0 || static_cast<size_t>(trackIndex) >= tracks->size())
+	{
+		return nullptr;
+	}
+
+	return &tracks->at(trackIndex);
+}
+
 void TracksList::load(const lib::spt::playlist &playlist)
 {
-	const auto &tracks = playlist.tracks.empty()
-		? cache.get_playlist(playlist.id).tracks
-		: playlist.tracks;
+	// Kept until refreshed, to not read it from cache again
+	const auto cached = std::make_shared<const lib::spt::playlist>(playlist.tracks.empty()
+		? cache.get_playlist(playlist.id)
+		: playlist);
 
-	if (!tracks.empty())
+	if (!cached->tracks.empty())
 	{
-		load(tracks);
+		load(cached->tracks);
 	}
 	else
 	{
@@ -309,14 +465,14 @@ void TracksList::load(const lib::spt::playlist &playlist)
 	}
 
 	const auto &snapshot = playlist.snapshot;
-	spotify.playlist(playlist.id, [this, snapshot](const lib::spt::playlist &loadedPlaylist)
+	spotify.playlist(playlist.id, [this, snapshot, cached](const lib::spt::playlist &loadedPlaylist)
 	{
 		if (this->isEnabled()
 			&& loadedPlaylist.is_up_to_date(snapshot))
 		{
 			return;
 		}
-		this->refreshPlaylist(loadedPlaylist);
+		this->refreshPlaylist(*cached, loadedPlaylist);
 	});
 
 	auto *mainWindow = MainWindow::find(parentWidget());
@@ -330,21 +486,36 @@ void TracksList::load(const lib::spt::playlist &playlist)
 }
 
 void TracksList::refreshPlaylist(const lib::spt::playlist &playlist)
+{
+	refreshPlaylist(cache.get_playlist(playlist.id), playlist);
+}
+
+void TracksList::refreshPlaylist(const lib::spt::playlist &cached,
+	const lib::spt::playlist &latest)
 {
 	auto *mainWindow = MainWindow::find(parentWidget());
-	if (lib::spt::api::to_uri("playlist", playlist.id) != mainWindow->getSptContext())
+	const auto context = lib::spt::api::to_uri("playlist", latest.id);
+	if (mainWindow == nullptr || context != mainWindow->getSptContext())
 	{
 		return;
 	}
 
-	spotify.playlist_tracks(playlist,
-		[this, playlist](const std::vector<lib::spt::track> &tracks)
+	// Only fetches new tracks if possible
+	spotify.playlist_tracks(cached, latest,
+		[this, mainWindow, context, latest](std::vector<lib::spt::track> &&tracks)
 		{
-			auto newPlaylist = playlist;
-			newPlaylist.tracks = tracks;
-			this->load(newPlaylist.tracks);
-			this->setEnabled(true);
+			auto newPlaylist = latest;
+			newPlaylist.tracks = std::move(tracks);
 			this->cache.set_playlist(newPlaylist);
+
+			// Another list was opened while fetching
+			if (context != mainWindow->getSptContext())
+			{
+				return;
+			}
+
+			this->update(std::move(newPlaylist.tracks), std::string());
+			this->setEnabled(true);
 		});
 }
 
@@ -361,11 +532,11 @@ void TracksList::load(const lib::spt::album &album, const std::string &trackId)
 	}
 
 	spotify.album_tracks(album,
-		[this, album, trackId](const std::vector<lib::spt::track> &tracks)
+		[this, album, trackId](std::vector<lib::spt::track> &&tracks)
 		{
-			this->load(tracks, trackId);
-			this->setEnabled(true);
 			cache.set_tracks(album.id, tracks);
+			this->update(std::move(tracks), trackId);
+			this->setEnabled(true);
 
 			auto *mainWindow = MainWindow::find(this->parentWidget());
 			if (mainWindow != nullptr)
@@ -375,27 +546,17 @@ void TracksList::load(const lib::spt::album &album, const std::string &trackId)
 		});
 }
 
-void TracksList::setPlayingTrackItem(QTreeWidgetItem *item)
+void TracksList::setPlayingTrackItem(const std::string &itemId)
 {
-	if (playingTrackItem != nullptr)
-	{
-		playingTrackItem->setIcon(0, emptyIcon);
-	}
-
-	if (item == nullptr)
-	{
-		playingTrackItem = nullptr;
-		return;
-	}
-	item->setIcon(0, Icon::get("media-playback-start"));
-	playingTrackItem = item;
+	const auto item = trackIndexes.find(lib::spt::api::to_packed_id(itemId));
+	trackListModel->setPlayingIndex(item != trackIndexes.end()
+		? item->second
+		: -1);
 }
 
-void TracksList::setPlayingTrackItem(const std::string &itemId)
+void TracksList::setTrackNumbers(bool enabled)
 {
-	setPlayingTrackItem(trackItems.find(itemId) != trackItems.end()
-		? trackItems[itemId]
-		: nullptr);
+	trackListModel->setTrackNumbers(enabled);
 }
 
 auto TracksList::getCurrent() -> const spt::Current &
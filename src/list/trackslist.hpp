@@ -5,12 +5,15 @@
 #include "spotify/current.hpp"
 #include "menu/songmenu.hpp"
 #include "lib/set.hpp"
+#include "lib/spotify/id.hpp"
 #include "enum/column.hpp"
+#include "model/tracklistmodel.hpp"
 
-#include <QListWidget>
-#include <QTreeWidgetItem>
+#include <QLineEdit>
+#include <QTreeView>
+#include <memory>
 
-class TracksList: public QTreeWidget
+class TracksList: public QTreeView
 {
 Q_OBJECT
 
@@ -19,19 +22,36 @@ public:
 		QWidget *parent);
 
 	void updateResizeMode(lib::resize_mode mode);
-	void setPlayingTrackItem(QTreeWidgetItem *item);
 	void setPlayingTrackItem(const std::string &itemId);
+	void setTrackNumbers(bool enabled);
 
 	/**
 	 * Load tracks directly, without cache, but select an item
 	 */
 	void load(const std::vector<lib::spt::track> &tracks, const std::string &selectedId);
 
+	/**
+	 * Load tracks directly, without cache, taking ownership of them
+	 */
+	void load(std::vector<lib::spt::track> &&tracks, const std::string &selectedId);
+
 	/**
 	 * Load tracks directly, without cache
 	 */
 	void load(const std::vector<lib::spt::track> &tracks);
 
+	/**
+	 * Replace tracks with a refreshed version of the same list,
+	 * only changing rows that changed, keeping scroll position and selection
+	 */
+	void update(const std::vector<lib::spt::track> &tracks);
+
+	/**
+	 * Replace tracks with a refreshed version of the same list, taking ownership of them
+	 * @param selectedId Item to select, if nothing is selected
+	 */
+	void update(std::vector<lib::spt::track> &&tracks, const std::string &selectedId);
+
 	/**
 	 * Load playlist first from cache, then refresh it
 	 */
@@ -47,24 +67,74 @@ public:
 	 */
 	void load(const lib::spt::album &album, const std::string &trackId = std::string());
 
+	/**
+	 * Currently loaded tracks, shared with rows, menus and playback
+	 * @note Never modified, a new list is created every time tracks are loaded
+	 */
+	auto getTracks() const -> std::shared_ptr<const std::vector<lib::spt::track>>;
+
+	/**
+	 * Track in row, only valid until tracks are loaded again
+	 * @return Track, or nullptr if not found
+	 */
+	auto getTrack(const QModelIndex &index) const -> const lib::spt::track *;
+
 protected:
 	void resizeEvent(QResizeEvent *event) override;
+	void updateGeometries() override;
+
+	/**
+	 * Typing in list filters it instead of jumping to first match
+	 */
+	void keyboardSearch(const QString &search) override;
 
 private:
 	void menu(const QPoint &pos);
-	void clicked(QTreeWidgetItem *item, int column);
+	void clicked(const QModelIndex &index);
 	void headerMenu(const QPoint &pos);
 	void resizeHeaders(const QSize &newSize);
 	auto getCurrent() -> const spt::Current &;
 
+	/**
+	 * Find tracks by ID and show playing track, after tracks changed
+	 */
+	void indexTracks();
+
+	/**
+	 * Select track, if loaded
+	 */
+	void selectTrack(const std::string &trackId);
+
+	/**
+	 * Show and focus filter bar, adding text to current filter
+	 */
+	void showFilter(const QString &text);
+
+	/**
+	 * Clear and hide filter bar, showing all tracks
+	 */
+	void closeFilter();
+
+	/**
+	 * Place filter bar in space below rows
+	 */
+	void placeFilterBar();
+
+	/**
+	 * Refresh tracks in playlist, only fetching what changed since cached
+	 * @param cached Playlist with tracks, as loaded from cache
+	 * @param latest Latest playlist, with snapshot and total tracks
+	 */
+	void refreshPlaylist(const lib::spt::playlist &cached, const lib::spt::playlist &latest);
+
 	// lib
 	lib::settings &settings;
 	lib::cache &cache;
 	// spt
 	spt::Spotify &spotify;
 	// std
-	std::unordered_map<std::string, QTreeWidgetItem *> trackItems;
+	std::unordered_map<lib::spt::id, int> trackIndexes;
 	// qt
-	QTreeWidgetItem *playingTrackItem = nullptr;
-	QIcon emptyIcon;
+	TrackListModel *trackListModel = nullptr;
+	QLineEdit *filterBar = nullptr;
 };
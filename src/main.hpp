@@ -1,7 +1,10 @@
 #pragma once
 
 #include "lib/cache/jsoncache.hpp"
+#include "lib/cache/cachewarmup.hpp"
+#include "lib/datetime.hpp"
 #include "lib/developermode.hpp"
+#include "lib/history/listeninghistory.hpp"
 #include "lib/log.hpp"
 #include "lib/spotify/playback.hpp"
 #include "lib/spotify/playlist.hpp"
@@ -16,7 +19,6 @@
 #include "list/librarylist.hpp"
 #include "list/playlistlist.hpp"
 #include "list/trackslist.hpp"
-#include "listitem/track.hpp"
 #include "mediaplayer/service.hpp"
 #include "menu/mainmenu.hpp"
 #include "menu/playlist.hpp"
@@ -34,7 +36,9 @@
 #include "widget/hiddensizegrip.hpp"
 #include "widget/maintoolbar.hpp"
 
+#include <QFutureWatcher>
 #include <QMainWindow>
 #include <QSplitter>
 #include <QStatusBar>
 #include <QSizeGrip>
+#include <QtConcurrentRun>
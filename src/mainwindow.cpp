@@ -3,7 +3,8 @@
 MainWindow::MainWindow(lib::settings &settings, lib::paths &paths)
 	: settings(settings),
 	paths(paths),
-	cache(paths)
+	cache(paths),
+	history(paths.cache() / "history")
 {
 	lib::crash_handler::set_cache(cache);
 
@@ -25,8 +26,15 @@ MainWindow::MainWindow(lib::settings &settings, lib::paths &paths)
 	// Check for dark background
 	StyleUtils::setDarkBackground(this);
 
+	// Keep decoded album images in memory
+	QPixmapCache::setCacheLimit(HttpUtils::albumCacheLimit);
+
 	// Set Spotify
 	splash.showMessage("Connecting...");
+
+	// Load from cache in the background while connecting
+	lib::cache_warm_up warmUp(cache, settings.general.last_playlist);
+
 	httpClient = new lib::qt::http_client(this);
 	spotify = new spt::Spotify(settings, *httpClient, this);
 	network = new QNetworkAccessManager(this);
@@ -48,6 +56,20 @@ MainWindow::MainWindow(lib::settings &settings, lib::paths &paths)
 		*httpClient, cache, this);
 	addToolBar(Qt::ToolBarArea::TopToolBarArea, toolBar);
 
+	// Wait for cache in the background, playlists are shown and refreshed when loaded
+	playlistList->setCacheLoading(true);
+	auto *cacheWatcher = new QFutureWatcher<void>(this);
+	QFutureWatcher<void>::connect(cacheWatcher, &QFutureWatcher<void>::finished,
+		this, [this, cacheWatcher, warmUp]()
+		{
+			cacheWatcher->deleteLater();
+			initCache(warmUp);
+		});
+	cacheWatcher->setFuture(QtConcurrent::run([warmUp]()
+	{
+		warmUp.wait();
+	}));
+
 	// Update player status
 	splash.showMessage("Refreshing...");
 	auto *timer = new QTimer(this);
@@ -92,6 +114,41 @@ void MainWindow::closeEvent(QCloseEvent *event)
 	event->accept();
 }
 
+void MainWindow::initCache(const lib::cache_warm_up &warmUp)
+{
+	// Album images are the only part of the cache that grows without limit
+	constexpr size_t bytesInMegabyte = 1000 * 1000;
+	const auto evicted = cache.evict("album",
+		static_cast<size_t>(settings.general.album_cache_size) * bytesInMegabyte);
+	if (evicted > 0)
+	{
+		lib::log::info("Removed {} album images from cache", evicted);
+	}
+
+	// Already loaded, so doesn't block
+	cachedTracks[lib::cache_warm_up::liked_tracks_id] = warmUp.liked_tracks();
+
+	auto playlists = warmUp.playlists();
+	if (!playlists.empty())
+	{
+		const auto lastPlaylist = warmUp.last_playlist();
+		for (auto &playlist : playlists)
+		{
+			if (playlist.id == lastPlaylist.id)
+			{
+				playlist.tracks = lastPlaylist.tracks;
+				break;
+			}
+		}
+
+		playlistList->load(playlists);
+	}
+
+	// Show cached playlists first, then refresh them once
+	playlistList->setCacheLoading(false);
+	playlistList->refresh();
+}
+
 void MainWindow::initClient()
 {
 	if (!settings.spotify.start_client)
@@ -280,8 +337,8 @@ void MainWindow::refreshed(const lib::spt::playback &playback)
 
 		if (trayIcon != nullptr && settings.general.tray_album_art)
 		{
-			HttpUtils::getAlbum(current.playback.item.image, *httpClient,
-				cache, [this](const QPixmap &image)
+			HttpUtils::getAlbum(current.playback.item.image, AlbumSize::Tray,
+				*httpClient, cache, [this](const QPixmap &image)
 				{
 					if (this->trayIcon != nullptr)
 					{
@@ -291,6 +348,8 @@ void MainWindow::refreshed(const lib::spt::playback &playback)
 		}
 	}
 
+	updateHistory();
+
 	toolBar->setProgress(current.playback);
 	toolBar->setPlaying(current.playback.is_playing);
 
@@ -304,6 +363,33 @@ void MainWindow::refreshed(const lib::spt::playback &playback)
 	toolBar->setShuffle(current.playback.shuffle);
 }
 
+void MainWindow::updateHistory()
+{
+	constexpr int minPlayMs = lib::listening_history::min_play_seconds * 1000;
+
+	const auto &track = current.playback.item;
+	const auto progress = current.playback.progress_ms;
+	const auto threshold = std::min(minPlayMs, track.duration / 2);
+
+	// New track, or same track started over
+	if (track.id != historyTrackId || progress < threshold)
+	{
+		historyTrackId = track.id;
+		historyAdded = false;
+	}
+
+	// Only count as played after listening to some of it, not when skipped
+	if (historyAdded || !current.playback.is_playing || progress < threshold)
+	{
+		return;
+	}
+
+	// Track started playing progress ago
+	history.add(track, lib::date_time::seconds_since_epoch() - progress / 1000,
+		lib::play_source::started);
+	historyAdded = true;
+}
+
 auto MainWindow::createCentralWidget() -> QWidget *
 {
 	// All widgets in container
@@ -311,7 +397,7 @@ auto MainWindow::createCentralWidget() -> QWidget *
 	sidePanel = new View::SidePanel::SidePanel(*spotify, settings, cache,
 		*httpClient, this);
 
-	libraryList = new LibraryList(*spotify, this);
+	libraryList = new LibraryList(*spotify, settings, this);
 	playlistList = new PlaylistList(*spotify, settings, cache, this);
 	contextView = new View::Context::Context(*spotify, current, cache, this);
 
@@ -373,12 +459,22 @@ auto MainWindow::loadAlbum(const std::string &albumId, const std::string &trackI
 
 auto MainWindow::loadTracksFromCache(const std::string &id) -> std::vector<lib::spt::track>
 {
+	// Already loaded at startup
+	auto cached = cachedTracks.find(id);
+	if (cached != cachedTracks.end())
+	{
+		auto tracks = cached->second;
+		cachedTracks.erase(cached);
+		return tracks;
+	}
+
 	return cache.get_tracks(id);
 }
 
 void MainWindow::saveTracksToCache(const std::string &id,
 	const std::vector<lib::spt::track> &tracks)
 {
+	cachedTracks.erase(id);
 	cache.set_tracks(id, tracks);
 }
 
@@ -410,13 +506,14 @@ void MainWindow::status(const std::string &message, bool important)
 
 void MainWindow::setAlbumImage(const std::string &url)
 {
-	HttpUtils::getAlbum(url, *httpClient, cache, [this](const QPixmap &image)
-	{
-		if (this->contextView != nullptr)
+	HttpUtils::getAlbum(url, AlbumSize::Context, *httpClient, cache,
+		[this](const QPixmap &image)
 		{
-			contextView->setAlbum(image);
-		}
-	});
+			if (this->contextView != nullptr)
+			{
+				contextView->setAlbum(image);
+			}
+		});
 }
 
 void MainWindow::openArtist(const std::string &artistId)
@@ -426,18 +523,18 @@ void MainWindow::openArtist(const std::string &artistId)
 
 auto MainWindow::currentTracks() -> std::vector<std::string>
 {
+	const auto *model = songs->model();
 	std::vector<std::string> tracks;
-	tracks.reserve(songs->topLevelItemCount());
+	tracks.reserve(model->rowCount());
 
-	for (int i = 0; i < songs->topLevelItemCount(); i++)
+	for (int i = 0; i < model->rowCount(); i++)
 	{
-		auto track = songs->topLevelItem(i)->data(0, RoleTrack)
-			.value<lib::spt::track>();
-		if (!track.is_valid())
+		const auto *track = songs->getTrack(model->index(i, 0));
+		if (track == nullptr || !track->is_valid())
 		{
 			continue;
 		}
-		tracks.push_back(lib::spt::api::to_uri("track", track.id));
+		tracks.push_back(lib::spt::api::to_uri("track", track->id));
 	}
 
 	return tracks;
@@ -465,13 +562,7 @@ void MainWindow::setFixedWidthTime(bool value)
 
 void MainWindow::toggleTrackNumbers(bool enabled)
 {
-	for (int i = 0; i < songs->topLevelItemCount(); i++)
-	{
-		auto *item = songs->topLevelItem(i);
-		item->setText(0, enabled
-			? QString("%1").arg(item->data(0, RoleIndex).toInt() + 1, 3)
-			: QString());
-	}
+	songs->setTrackNumbers(enabled);
 }
 
 //region Getters
@@ -537,6 +628,11 @@ auto MainWindow::getClientHandler() -> const spt::ClientHandler *
 	return sptClient;
 }
 
+auto MainWindow::getHistory() -> lib::listening_history &
+{
+	return history;
+}
+
 #ifdef USE_DBUS
 auto MainWindow::getMediaPlayer() -> mp::Service *
 {
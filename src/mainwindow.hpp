@@ -69,6 +69,7 @@ public:
 	lib::spt::playback &getCurrentPlayback();
 	const spt::Current &getCurrent();
 	auto getClientHandler() -> const spt::ClientHandler *;
+	auto getHistory() -> lib::listening_history &;
 	void resetLibraryPlaylist() const;
 
 #ifdef USE_DBUS
@@ -93,6 +94,8 @@ private:
 	lib::settings &settings;
 	lib::paths &paths;
 	lib::json_cache cache;
+	lib::listening_history history;
+	std::unordered_map<std::string, std::vector<lib::spt::track>> cachedTracks;
 	lib::spt::user currentUser;
 	lib::http_client *httpClient = nullptr;
 
@@ -102,6 +105,8 @@ private:
 	// Other
 	TrayIcon *trayIcon = nullptr;
 	int refreshCount = -1;
+	std::string historyTrackId;
+	bool historyAdded = false;
 	bool stateValid = true;
 	QDockWidget *sidePanel = nullptr;
 
@@ -118,9 +123,16 @@ private:
 	void initMediaController();
 	void initWhatsNew();
 	void initDevice();
+	void initCache(const lib::cache_warm_up &warmUp);
 
 	// Methods
 	QWidget *createCentralWidget();
 	void setAlbumImage(const std::string &url);
 	void setSptContext(const std::string &uri);
+
+	/**
+	 * Add current track to listening history,
+	 * once it has been playing for 30 seconds or half its duration
+	 */
+	void updateHistory();
 };
@@ -107,6 +107,15 @@ auto DeveloperMenu::infoMenu() -> QMenu *
 			QString::fromStdString(mainWindow->getSptContext()));
 	});
 
+	addMenuItem(menu, "Cache writes", [this, mainWindow]()
+	{
+		const auto writes = cache.get_writes();
+		QMessageBox::information(mainWindow, "Cache writes",
+			QString("Written: %1\nSkipped (unchanged): %2")
+				.arg(writes.written)
+				.arg(writes.skipped));
+	});
+
 	return menu;
 }
 
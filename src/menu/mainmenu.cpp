@@ -44,6 +44,21 @@ MainMenu::MainMenu(lib::spt::api &spotify, lib::settings &settings,
 	});
 	addAction(openSettings);
 
+	// Statistics from local history
+	auto *openStats = MenuUtils::createAction("view-statistics",
+		"Listening statistics", this);
+	QAction::connect(openStats, &QAction::triggered, [this]()
+	{
+		auto *mainWindow = MainWindow::find(parentWidget());
+		if (mainWindow == nullptr)
+		{
+			return;
+		}
+		mainWindow->addSidePanelTab(new View::ListeningStats(mainWindow->getHistory(),
+			mainWindow), "Statistics");
+	});
+	addAction(openStats);
+
 	// Debug options if enabled
 	if (lib::developer_mode::enabled)
 	{
@@ -3,6 +3,7 @@
 #include "lib/spotify/api.hpp"
 
 #include "menu/developermenu.hpp"
+#include "view/listeningstats.hpp"
 #include "util/menuutils.hpp"
 
 #include <QMenu>
@@ -51,10 +51,11 @@ Menu::Playlist::Playlist(lib::spt::api &spotify, const lib::spt::playlist &playl
 
 	if (cached.is_null() || !playlist.is_up_to_date(cached.snapshot))
 	{
-		spotify.playlist_tracks(playlist, [this](const std::vector<lib::spt::track> &items)
-		{
-			tracksLoaded(items);
-		});
+		spotify.playlist_tracks(cached, playlist,
+			[this](const std::vector<lib::spt::track> &items)
+			{
+				tracksLoaded(items);
+			});
 	}
 }
 
@@ -235,26 +235,27 @@ void SongMenu::remFromPlaylist(bool /*checked*/)
 			}
 
 			// Remove from interface
-			QTreeWidgetItem *item = nullptr;
-			int i;
-			for (i = 0; i < mainWindow->getSongsTree()->topLevelItemCount(); i++)
+			auto *songs = mainWindow->getSongsTree();
+			auto *model = songs->model();
+			auto row = -1;
+			for (auto i = 0; i < model->rowCount(); i++)
 			{
-				item = mainWindow->getSongsTree()->topLevelItem(i);
-				if (item->data(0, RoleTrack).value<lib::spt::track>().id == track.id)
+				const auto *itemTrack = songs->getTrack(model->index(i, 0));
+				if (itemTrack != nullptr && itemTrack->id == track.id)
 				{
+					row = i;
 					break;
 				}
-				item = nullptr;
 			}
 
-			if (item == nullptr)
+			if (row < 0)
 			{
 				mainWindow->setStatus("Failed to remove track, not found in playlist", true);
 				return;
 			}
 
-			// i doesn't necessarily match item index depending on sorting order
-			mainWindow->getSongsTree()->takeTopLevelItem(i);
+			// Row doesn't necessarily match track index depending on sorting order
+			model->removeRow(row);
 			mainWindow->status(lib::fmt::format("Removed {} - {} from \"{}\"",
 				track.name,
 				lib::spt::entity::combine_names(track.artists),
@@ -1,75 +1,711 @@
 #include "tracklistmodel.hpp"
 
-TrackListModel::TrackListModel(QObject *parent)
-	: QAbstractListModel(parent)
+#include "util/dateutils.hpp"
+#include "util/icon.hpp"
+
+#include "lib/listdiff.hpp"
+
+#include <QLocale>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
+constexpr size_t TrackListModel::backgroundSortRows;
+constexpr size_t TrackListModel::maxRowChanges;
+
+TrackListModel::TrackListModel(const lib::settings &settings, QObject *parent)
+	: settings(settings),
+	columns(std::make_shared<lib::track_columns>()),
+	trackNumbers(settings.general.track_numbers == lib::context_all),
+	QAbstractTableModel(parent)
 {
+	constexpr int emptyPixmapSize = 64;
+
+	// Empty icon used as replacement for play icon
+	QPixmap emptyPixmap(emptyPixmapSize, emptyPixmapSize);
+	emptyPixmap.fill(Qt::transparent);
+	emptyIcon = QIcon(emptyPixmap);
+
+	playingIcon = Icon::get("media-playback-start");
+
+	connect(this, &TrackListModel::sortFinished,
+		this, &TrackListModel::onSortFinished, Qt::QueuedConnection);
 }
 
-void TrackListModel::add(const std::vector<lib::spt::track> &items)
+TrackListModel::~TrackListModel()
 {
-	beginInsertRows(QModelIndex(), rowCount(),
-		static_cast<int>(rowCount() + tracks.size() - 1));
-	lib::vector::append(tracks, items);
-	endInsertRows();
+	if (sortFuture.valid())
+	{
+		sortFuture.wait();
+	}
 }
 
-void TrackListModel::clear()
+void TrackListModel::load(const std::shared_ptr<const std::vector<lib::spt::track>> &newTracks)
 {
-	beginRemoveRows(QModelIndex(), 0,
-		static_cast<int>(tracks.size() - 1));
-	tracks.clear();
-	endRemoveRows();
+	beginResetModel();
+
+	tracks = newTracks;
+	columns = tracks
+		? std::make_shared<lib::track_columns>(*tracks)
+		: std::make_shared<lib::track_columns>();
+	sortKeys.reset();
+	trackFilter = lib::track_filter(*columns);
+	updateFilter();
+
+	// Shown in loaded order until sorted
+	order.resize(columns->size());
+	std::iota(order.begin(), order.end(), 0);
+	removed.assign(columns->size(), false);
+
+	rows.clear();
+	for (const auto trackIndex : order)
+	{
+		if (matchesFilter.at(trackIndex))
+		{
+			rows.push_back(trackIndex);
+		}
+	}
+	trackRows.clear();
+
+	playingIndex = -1;
+	fieldWidth = static_cast<int>(std::to_string(columns->size()).size());
+
+	endResetModel();
+
+	sort(sortColumn, sortOrder);
+}
+
+auto TrackListModel::update(const std::shared_ptr<const std::vector<lib::spt::track>> &newTracks)
+-> bool
+{
+	if (!tracks || !newTracks || tracks->empty() || newTracks->empty())
+	{
+		load(newTracks);
+		return true;
+	}
+
+	const lib::track_diff diff(*tracks, *newTracks);
+	if (diff.empty())
+	{
+		tracks = newTracks;
+		return false;
+	}
+
+	const auto &nextIndices = diff.next_indices();
+	const auto newColumns = std::make_shared<lib::track_columns>(*newTracks);
+	const auto size = newColumns->size();
+	const auto column = static_cast<lib::track_column>(sortColumn);
+	const auto background = column != lib::track_column::index
+		&& size >= backgroundSortRows;
+
+	// Removed rows stay removed
+	std::vector<bool> newRemoved(size, false);
+	for (size_t i = 0; i < nextIndices.size(); i++)
+	{
+		if (nextIndices.at(i) != lib::track_diff::npos)
+		{
+			newRemoved.at(nextIndices.at(i)) = removed.at(i);
+		}
+	}
+
+	std::shared_ptr<const lib::track_sort_keys> newSortKeys;
+	std::vector<size_t> newOrder;
+
+	if (background)
+	{
+		// Previous order, with new tracks last, until sorted
+		std::vector<bool> isInOrder(size, false);
+		for (const auto trackIndex : order)
+		{
+			const auto next = nextIndices.at(trackIndex);
+			if (next != lib::track_diff::npos)
+			{
+				newOrder.push_back(next);
+				isInOrder.at(next) = true;
+			}
+		}
+		for (size_t i = 0; i < size; i++)
+		{
+			if (!isInOrder.at(i))
+			{
+				newOrder.push_back(i);
+			}
+		}
+	}
+	else if (column == lib::track_column::index)
+	{
+		// Sorted by index, so keys aren't needed yet
+		newOrder = lib::track_sort_keys(*newColumns, column)
+			.sort(column, sortOrder == Qt::AscendingOrder);
+	}
+	else
+	{
+		newSortKeys = std::make_shared<lib::track_sort_keys>(*newColumns);
+		newOrder = newSortKeys->sort(column, sortOrder == Qt::AscendingOrder);
+	}
+
+	lib::track_filter newFilter(*newColumns);
+	std::vector<bool> newMatches(size, false);
+	for (const auto trackIndex : newFilter.filter(filterText))
+	{
+		newMatches.at(trackIndex) = true;
+	}
+
+	std::vector<size_t> newRows;
+	for (const auto trackIndex : newOrder)
+	{
+		if (newMatches.at(trackIndex) && !newRemoved.at(trackIndex))
+		{
+			newRows.push_back(trackIndex);
+		}
+	}
+
+	const auto applyTracks = [&]()
+	{
+		tracks = newTracks;
+		columns = newColumns;
+		sortKeys = newSortKeys;
+		trackFilter = std::move(newFilter);
+		matchesFilter = std::move(newMatches);
+		removed = std::move(newRemoved);
+		order = std::move(newOrder);
+
+		const auto playing = playingIndex >= 0
+			? nextIndices.at(static_cast<size_t>(playingIndex))
+			: lib::track_diff::npos;
+		playingIndex = playing != lib::track_diff::npos
+			? static_cast<int>(playing)
+			: -1;
+		fieldWidth = static_cast<int>(std::to_string(size).size());
+
+		sortGeneration++;
+		appliedGeneration = sortGeneration;
+	};
+
+	const lib::list_diff rowDiff(diff.keys(rows), newRows, maxRowChanges);
+
+	if (rowDiff.exceeds_limit())
+	{
+		emit layoutAboutToBeChanged();
+
+		std::vector<size_t> previousTracks;
+		previousTracks.reserve(rows.size());
+		for (const auto trackIndex : rows)
+		{
+			previousTracks.push_back(nextIndices.at(trackIndex));
+		}
+
+		applyTracks();
+		rows = std::move(newRows);
+		trackRows.clear();
+		remapPersistentIndices(previousTracks);
+
+		emit layoutChanged();
+	}
+	else
+	{
+		const auto &changes = rowDiff.changes();
+		auto change = changes.cbegin();
+
+		// Removed while rows still show previous tracks, last first
+		while (change != changes.cend() && change->type == lib::list_diff::change_type::remove)
+		{
+			auto first = change->from;
+			const auto last = first;
+			while (++change != changes.cend()
+				&& change->type == lib::list_diff::change_type::remove
+				&& change->from + 1 == first)
+			{
+				first = change->from;
+			}
+
+			beginRemoveRows(QModelIndex(), static_cast<int>(first), static_cast<int>(last));
+			rows.erase(rows.begin() + static_cast<long>(first),
+				rows.begin() + static_cast<long>(last) + 1);
+			trackRows.clear();
+			endRemoveRows();
+		}
+
+		// Remaining rows show the same tracks, at their new index
+		for (auto &trackIndex : rows)
+		{
+			trackIndex = nextIndices.at(trackIndex);
+		}
+		applyTracks();
+		trackRows.clear();
+
+		for (; change != changes.cend(); change++)
+		{
+			const auto from = static_cast<int>(change->from);
+			const auto to = static_cast<int>(change->to);
+
+			if (change->type == lib::list_diff::change_type::insert)
+			{
+				beginInsertRows(QModelIndex(), to, to);
+				rows.insert(rows.begin() + to, newRows.at(change->from));
+				trackRows.clear();
+				endInsertRows();
+				continue;
+			}
+
+			beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+			const auto trackIndex = rows.at(from);
+			rows.erase(rows.begin() + from);
+			rows.insert(rows.begin() + (to > from ? to - 1 : to), trackIndex);
+			trackRows.clear();
+			endMoveRows();
+		}
+
+		// Track numbers and details can change without rows changing
+		if (!rows.empty())
+		{
+			emit dataChanged(index(0, 0),
+				index(static_cast<int>(rows.size()) - 1, columnCount(QModelIndex()) - 1));
+		}
+	}
+
+	if (background)
+	{
+		sort(sortColumn, sortOrder);
+	}
+
+	return true;
+}
+
+void TrackListModel::setFilter(const QString &text)
+{
+	filterText = text.toStdString();
+	updateFilter();
+	updateRows(QAbstractItemModel::NoLayoutChangeHint);
+}
+
+auto TrackListModel::getTracks() const -> std::shared_ptr<const std::vector<lib::spt::track>>
+{
+	return tracks;
+}
+
+auto TrackListModel::trackIndex(const QModelIndex &index) const -> int
+{
+	if (!index.isValid() || index.row() < 0
+		|| static_cast<size_t>(index.row()) >= rows.size())
+	{
+		return -1;
+	}
+	return static_cast<int>(rows.at(index.row()));
 }
 
-auto TrackListModel::rowCount(const QModelIndex &/*parent*/) const -> int
+auto TrackListModel::row(int trackIndex) const -> int
 {
-	return static_cast<int>(tracks.size());
+	if (trackIndex < 0 || static_cast<size_t>(trackIndex) >= columns->size())
+	{
+		return -1;
+	}
+
+	if (trackRows.size() != columns->size())
+	{
+		trackRows.assign(columns->size(), -1);
+		for (size_t i = 0; i < rows.size(); i++)
+		{
+			trackRows.at(rows.at(i)) = static_cast<int>(i);
+		}
+	}
+
+	return trackRows.at(static_cast<size_t>(trackIndex));
 }
 
-auto TrackListModel::rowCount() const -> int
+void TrackListModel::setPlayingIndex(int trackIndex)
 {
-	return rowCount(QModelIndex());
+	const auto previousRow = row(playingIndex);
+	playingIndex = trackIndex;
+
+	for (const auto changedRow : {previousRow, row(playingIndex)})
+	{
+		if (changedRow >= 0)
+		{
+			const auto changed = index(changedRow, static_cast<int>(Column::Index));
+			emit dataChanged(changed, changed, {Qt::DecorationRole});
+		}
+	}
 }
 
-auto TrackListModel::columnCount(const QModelIndex &/*parent*/) const -> int
+void TrackListModel::setTrackNumbers(bool enabled)
+{
+	trackNumbers = enabled;
+
+	const auto column = static_cast<int>(Column::Index);
+	emit headerDataChanged(Qt::Horizontal, column, column);
+	if (!rows.empty())
+	{
+		emit dataChanged(index(0, column),
+			index(static_cast<int>(rows.size()) - 1, column), {Qt::DisplayRole});
+	}
+}
+
+auto TrackListModel::rowCount(const QModelIndex &parent) const -> int
+{
+	return parent.isValid()
+		? 0
+		: static_cast<int>(rows.size());
+}
+
+auto TrackListModel::columnCount(const QModelIndex &parent) const -> int
 {
 	constexpr int columnCount = 6;
-	return columnCount;
+
+	return parent.isValid()
+		? 0
+		: columnCount;
 }
 
 auto TrackListModel::data(const QModelIndex &index, int role) const -> QVariant
 {
-	if (index.row() < 0 || index.row() >= tracks.size())
+	const auto trackIndex = this->trackIndex(index);
+	if (trackIndex < 0)
 	{
 		return QVariant();
 	}
 
-	switch (static_cast<TrackListRole>(role))
+	const auto column = static_cast<Column>(index.column());
+
+	switch (role)
 	{
-		case TrackListRole::Track:
-			return QVariant::fromValue(tracks.at(index.row()));
+		case Qt::DisplayRole:
+			return text(trackIndex, column);
+
+		case Qt::ToolTipRole:
+			return toolTip(trackIndex, column);
 
-		case TrackListRole::Index:
-			return index.row();
+		case Qt::DecorationRole:
+			if (column != Column::Index)
+			{
+				return QVariant();
+			}
+			return trackIndex == playingIndex
+				? playingIcon
+				: emptyIcon;
+
+		case RoleIndex:
+			return trackIndex;
+
+		default:
+			return QVariant();
+	}
+}
+
+auto TrackListModel::headerData(int section, Qt::Orientation orientation,
+	int role) const -> QVariant
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+	{
+		return QVariant();
+	}
+
+	switch (static_cast<Column>(section))
+	{
+		case Column::Index:
+			return trackNumbers ? QStringLiteral("#") : QString();
+
+		case Column::Title:
+			return QStringLiteral("Title");
+
+		case Column::Artist:
+			return QStringLiteral("Artist");
+
+		case Column::Album:
+			return QStringLiteral("Album");
+
+		case Column::Length:
+			return QStringLiteral("Length");
+
+		case Column::Added:
+			return QStringLiteral("Added");
 	}
 
 	return QVariant();
 }
 
-auto TrackListModel::data(const QModelIndex &index) const -> QVariant
+auto TrackListModel::flags(const QModelIndex &index) const -> Qt::ItemFlags
 {
-	return data(index, Qt::DisplayRole);
+	const auto trackIndex = this->trackIndex(index);
+	if (trackIndex < 0)
+	{
+		return Qt::NoItemFlags;
+	}
+
+	// Local and unavailable tracks can't be played
+	const auto row = static_cast<size_t>(trackIndex);
+	return columns->is_local(row) || !columns->is_playable(row)
+		? Qt::ItemIsSelectable | Qt::ItemNeverHasChildren
+		: Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
 }
 
-auto TrackListModel::roleNames() const -> QHash<int, QByteArray>
+void TrackListModel::sort(int column, Qt::SortOrder order)
 {
-	return {
-		{static_cast<int>(TrackListRole::Track), "track"},
-		{static_cast<int>(TrackListRole::Index), "index"},
-	};
+	sortColumn = column;
+	sortOrder = order;
+	sortGeneration++;
+
+	const auto trackColumn = static_cast<lib::track_column>(sortColumn);
+	if (trackColumn == lib::track_column::index
+		|| columns->size() < backgroundSortRows)
+	{
+		appliedGeneration = sortGeneration;
+		applySort(sortedOrder(trackColumn, sortOrder == Qt::AscendingOrder));
+		return;
+	}
+
+	// Already sorting, sorted again when done
+	if (sortFuture.valid()
+		&& sortFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return;
+	}
+
+	startSort();
+}
+
+auto TrackListModel::removeRows(int row, int count, const QModelIndex &parent) -> bool
+{
+	if (parent.isValid() || row < 0 || count <= 0
+		|| static_cast<size_t>(row + count) > rows.size())
+	{
+		return false;
+	}
+
+	// Track stays in loaded tracks, it's only no longer shown
+	beginRemoveRows(parent, row, row + count - 1);
+	for (auto i = row; i < row + count; i++)
+	{
+		removed.at(rows.at(i)) = true;
+	}
+	rows.erase(rows.begin() + row, rows.begin() + row + count);
+	trackRows.clear();
+	endRemoveRows();
+
+	return true;
+}
+
+auto TrackListModel::text(size_t trackIndex, Column column) const -> QString
+{
+	switch (column)
+	{
+		case Column::Index:
+			return trackNumbers
+				? QString("%1").arg(trackIndex + 1, fieldWidth)
+				: QString();
+
+		case Column::Title:
+			return QString::fromStdString(columns->name(trackIndex));
+
+		case Column::Artist:
+			return QString::fromStdString(columns->artist(trackIndex));
+
+		case Column::Album:
+			return QString::fromStdString(columns->album(trackIndex));
+
+		case Column::Length:
+			return QString::fromStdString(lib::fmt::time(columns->duration(trackIndex)));
+
+		case Column::Added:
+		{
+			const auto &addedAt = tracks->at(trackIndex).added_at;
+			if (addedAt.empty())
+			{
+				return QString();
+			}
+			return settings.general.relative_added
+				? DateUtils::toRelative(addedAt)
+				: QLocale().toString(DateUtils::fromIso(addedAt).date(),
+					QLocale::ShortFormat);
+		}
+	}
+
+	return QString();
+}
+
+auto TrackListModel::toolTip(size_t trackIndex, Column column) const -> QString
+{
+	const auto &track = tracks->at(trackIndex);
+
+	switch (column)
+	{
+		case Column::Index:
+			return QString();
+
+		case Column::Title:
+			if (track.is_local || !track.is_playable)
+			{
+				return track.is_local
+					? QStringLiteral("Local track")
+					: QStringLiteral("Unavailable");
+			}
+			return text(trackIndex, column);
+
+		case Column::Artist:
+			return QString::fromStdString(lib::spt::entity::combine_names(track.artists, "\n"));
+
+		case Column::Album:
+			return text(trackIndex, column);
+
+		case Column::Length:
+		{
+			const auto length = text(trackIndex, column).split(':');
+			if (length.length() < 2)
+			{
+				return QString();
+			}
+			return QString("%1m %2s (%3s total)")
+				.arg(length.at(0), length.at(1))
+				.arg(track.duration / 1000);
+		}
+
+		case Column::Added:
+		{
+			const auto addedAt = DateUtils::fromIso(track.added_at);
+			return DateUtils::isEmpty(addedAt)
+				? QString()
+				: QLocale().toString(addedAt.date());
+		}
+	}
+
+	return QString();
 }
 
-auto TrackListModel::parent(const QModelIndex &/*child*/) const -> QModelIndex
+auto TrackListModel::getSortKeys() -> std::shared_ptr<const lib::track_sort_keys>
 {
-	return {};
+	if (!sortKeys)
+	{
+		sortKeys = std::make_shared<lib::track_sort_keys>(*columns);
+	}
+	return sortKeys;
+}
+
+auto TrackListModel::sortedOrder(lib::track_column column, bool ascending) -> std::vector<size_t>
+{
+	// Index order is known without creating keys for every column
+	if (column == lib::track_column::index)
+	{
+		return lib::track_sort_keys(*columns, column).sort(column, ascending);
+	}
+	return getSortKeys()->sort(column, ascending);
+}
+
+void TrackListModel::startSort()
+{
+	const auto generation = sortGeneration;
+	const auto sortColumns = columns;
+	const auto keys = sortKeys;
+	const auto column = static_cast<lib::track_column>(sortColumn);
+	const auto ascending = sortOrder == Qt::AscendingOrder;
+
+	sortFuture = std::async(std::launch::async,
+		[this, generation, sortColumns, keys, column, ascending]()
+		{
+			const auto sortedKeys = keys
+				? keys
+				: std::make_shared<lib::track_sort_keys>(*sortColumns);
+
+			auto sorted = sortedKeys->sort(column, ascending);
+			{
+				std::lock_guard<std::mutex> lock(sortMutex);
+				sortResult.generation = generation;
+				sortResult.columns = sortColumns;
+				sortResult.keys = sortedKeys;
+				sortResult.rows = std::move(sorted);
+			}
+
+			emit sortFinished();
+		});
+}
+
+void TrackListModel::onSortFinished()
+{
+	SortResult result;
+	{
+		std::lock_guard<std::mutex> lock(sortMutex);
+		std::swap(result, sortResult);
+	}
+
+	// Tracks were replaced while sorting
+	if (result.columns != columns)
+	{
+		if (appliedGeneration != sortGeneration)
+		{
+			startSort();
+		}
+		return;
+	}
+
+	if (!sortKeys)
+	{
+		sortKeys = result.keys;
+	}
+
+	if (result.generation == sortGeneration)
+	{
+		appliedGeneration = sortGeneration;
+		applySort(std::move(result.rows));
+	}
+	else if (appliedGeneration != sortGeneration)
+	{
+		startSort();
+	}
+}
+
+void TrackListModel::applySort(std::vector<size_t> &&sortedRows)
+{
+	order = std::move(sortedRows);
+	updateRows(QAbstractItemModel::VerticalSortHint);
+}
+
+void TrackListModel::updateFilter()
+{
+	matchesFilter.assign(columns->size(), false);
+	for (const auto trackIndex : trackFilter.filter(filterText))
+	{
+		matchesFilter.at(trackIndex) = true;
+	}
+}
+
+void TrackListModel::updateRows(QAbstractItemModel::LayoutChangeHint hint)
+{
+	emit layoutAboutToBeChanged({}, hint);
+
+	const auto previousRows = std::move(rows);
+	rows.clear();
+	for (const auto trackIndex : order)
+	{
+		if (matchesFilter.at(trackIndex) && !removed.at(trackIndex))
+		{
+			rows.push_back(trackIndex);
+		}
+	}
+	trackRows.clear();
+
+	remapPersistentIndices(previousRows);
+
+	emit layoutChanged({}, hint);
+}
+
+void TrackListModel::remapPersistentIndices(const std::vector<size_t> &previousTracks)
+{
+	// Row each track ended up in, or -1 if no longer shown
+	std::vector<int> newRows(columns->size(), -1);
+	for (size_t i = 0; i < rows.size(); i++)
+	{
+		newRows.at(rows.at(i)) = static_cast<int>(i);
+	}
+
+	const auto from = persistentIndexList();
+	QModelIndexList to;
+	to.reserve(from.size());
+	for (const auto &index : from)
+	{
+		const auto trackIndex = previousTracks.at(index.row());
+		to.append(this->index(trackIndex == lib::track_diff::npos
+			? -1
+			: newRows.at(trackIndex), index.column()));
+	}
+	changePersistentIndexList(from, to);
 }
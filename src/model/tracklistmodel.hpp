@@ -1,36 +1,215 @@
 #pragma once
 
-#include "role/tracklistroles.hpp"
+#include "enum/column.hpp"
+#include "enum/datarole.hpp"
+#include "lib/settings.hpp"
 #include "lib/spotify/track.hpp"
+#include "lib/tracks/trackcolumns.hpp"
+#include "lib/tracks/trackdiff.hpp"
+#include "lib/tracks/trackfilter.hpp"
+#include "lib/tracks/tracksortkeys.hpp"
 #include "metatypes.hpp"
-#include "lib/vector.hpp"
 
-#include <QAbstractListModel>
+#include <QAbstractTableModel>
+#include <QIcon>
 
-class TrackListModel: public QAbstractListModel
+#include <future>
+#include <memory>
+#include <mutex>
+
+/**
+ * Tracks in the main track list
+ * @note Text is only created when a row is shown, rows only store an index
+ * @note Large lists are sorted in the background, and keep their order until done
+ */
+class TrackListModel: public QAbstractTableModel
 {
 Q_OBJECT
 
 public:
-	explicit TrackListModel(QObject *parent);
+	TrackListModel(const lib::settings &settings, QObject *parent);
+	~TrackListModel() override;
 
-	void add(const std::vector<lib::spt::track> &tracks);
+	/**
+	 * Replace all tracks, keeping current sort order
+	 */
+	void load(const std::shared_ptr<const std::vector<lib::spt::track>> &tracks);
 
-	void clear();
+	/**
+	 * Replace tracks with a refreshed version of the same list,
+	 * only adding, removing and moving rows that changed
+	 * @note Scroll position and selection are kept
+	 * @return Any track changed
+	 */
+	auto update(const std::shared_ptr<const std::vector<lib::spt::track>> &tracks) -> bool;
 
-	auto rowCount(const QModelIndex &parent) const -> int override;
-	auto rowCount() const -> int;
+	/**
+	 * Only show tracks where title, artist or album contains text,
+	 * kept when loading new tracks
+	 */
+	void setFilter(const QString &text);
+
+	/**
+	 * Loaded tracks, in original order
+	 */
+	auto getTracks() const -> std::shared_ptr<const std::vector<lib::spt::track>>;
+
+	/**
+	 * Index of track in row
+	 * @return Index in loaded tracks, or -1 if not found
+	 */
+	auto trackIndex(const QModelIndex &index) const -> int;
 
+	/**
+	 * Row track is shown in
+	 * @param trackIndex Index in loaded tracks
+	 * @return Row, or -1 if not shown
+	 */
+	auto row(int trackIndex) const -> int;
+
+	/**
+	 * Show track as playing
+	 * @param trackIndex Index in loaded tracks, or -1 for none
+	 */
+	void setPlayingIndex(int trackIndex);
+
+	void setTrackNumbers(bool enabled);
+
+	auto rowCount(const QModelIndex &parent) const -> int override;
 	auto columnCount(const QModelIndex &parent) const -> int override;
 
 	auto data(const QModelIndex &index, int role) const -> QVariant override;
-	auto data(const QModelIndex &index) const -> QVariant;
+	auto headerData(int section, Qt::Orientation orientation,
+		int role) const -> QVariant override;
+	auto flags(const QModelIndex &index) const -> Qt::ItemFlags override;
 
-	auto parent(const QModelIndex &child) const -> QModelIndex override;
+	void sort(int column, Qt::SortOrder order) override;
+	auto removeRows(int row, int count, const QModelIndex &parent) -> bool override;
 
-protected:
-	auto roleNames() const -> QHash<int, QByteArray> override;
+signals:
+	/**
+	 * Background sort finished
+	 * @note Emitted from sorting thread
+	 */
+	void sortFinished();
 
 private:
-	std::vector<lib::spt::track> tracks;
+	/**
+	 * Lists with at least this many rows are sorted in the background
+	 */
+	static constexpr size_t backgroundSortRows = 10000;
+
+	/**
+	 * When updating needs more changes, rows are changed in one layout change instead
+	 */
+	static constexpr size_t maxRowChanges = 1000;
+
+	const lib::settings &settings;
+
+	std::shared_ptr<const std::vector<lib::spt::track>> tracks;
+	std::shared_ptr<const lib::track_columns> columns;
+
+	/**
+	 * Created on first sort, then reused until new tracks are loaded
+	 */
+	std::shared_ptr<const lib::track_sort_keys> sortKeys;
+
+	/**
+	 * Index in loaded tracks for each row
+	 */
+	std::vector<size_t> rows;
+
+	/**
+	 * Row of each loaded track, or -1 if not shown,
+	 * created when first needed after rows change
+	 */
+	mutable std::vector<int> trackRows;
+
+	/**
+	 * All loaded tracks, in current sort order
+	 */
+	std::vector<size_t> order;
+
+	/**
+	 * If loaded track was removed from list
+	 */
+	std::vector<bool> removed;
+
+	lib::track_filter trackFilter;
+	std::string filterText;
+
+	/**
+	 * If loaded track matches current filter
+	 */
+	std::vector<bool> matchesFilter;
+
+	int playingIndex = -1;
+	int sortColumn = 0;
+	Qt::SortOrder sortOrder = Qt::AscendingOrder;
+	bool trackNumbers;
+	int fieldWidth = 0;
+
+	/**
+	 * Increased for every requested sort, to ignore outdated results
+	 */
+	unsigned int sortGeneration = 0;
+	unsigned int appliedGeneration = 0;
+	std::future<void> sortFuture;
+
+	/**
+	 * Result from background sort, guarded by sortMutex
+	 */
+	struct SortResult
+	{
+		unsigned int generation = 0;
+		std::shared_ptr<const lib::track_columns> columns;
+		std::shared_ptr<const lib::track_sort_keys> keys;
+		std::vector<size_t> rows;
+	};
+
+	std::mutex sortMutex;
+	SortResult sortResult;
+
+	QIcon emptyIcon;
+	QIcon playingIcon;
+
+	auto text(size_t trackIndex, Column column) const -> QString;
+	auto toolTip(size_t trackIndex, Column column) const -> QString;
+
+	/**
+	 * Sort keys, created if not already
+	 */
+	auto getSortKeys() -> std::shared_ptr<const lib::track_sort_keys>;
+
+	/**
+	 * Loaded tracks in sort order, only creating sort keys if needed
+	 */
+	auto sortedOrder(lib::track_column column, bool ascending) -> std::vector<size_t>;
+
+	/**
+	 * Sort in the background, unless already sorting
+	 */
+	void startSort();
+
+	void applySort(std::vector<size_t> &&sortedRows);
+
+	/**
+	 * Update which tracks match filter, without updating rows
+	 */
+	void updateFilter();
+
+	/**
+	 * Show tracks in sort order that match filter and aren't removed,
+	 * and update persistent indices, in one layout change
+	 */
+	void updateRows(QAbstractItemModel::LayoutChangeHint hint);
+
+	/**
+	 * Move persistent indices to the row their track is in now
+	 * @param previousTracks Track shown in each row before, as index in tracks,
+	 * or lib::track_diff::npos if no longer loaded
+	 */
+	void remapPersistentIndices(const std::vector<size_t> &previousTracks);
+
+	void onSortFinished();
 };
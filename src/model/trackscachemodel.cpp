@@ -0,0 +1,125 @@
+#include "trackscachemodel.hpp"
+
+#include "lib/cache/cachedtracks.hpp"
+
+#include <numeric>
+
+TracksCacheModel::TracksCacheModel(QObject *parent)
+	: QAbstractTableModel(parent)
+{
+}
+
+void TracksCacheModel::load(const lib::cache &cache)
+{
+	beginResetModel();
+
+	columns = lib::cached_tracks::load(cache);
+
+	// Shown in loaded order until sorted
+	rows.resize(columns.size());
+	std::iota(rows.begin(), rows.end(), 0);
+
+	endResetModel();
+}
+
+auto TracksCacheModel::rowCount(const QModelIndex &parent) const -> int
+{
+	return parent.isValid()
+		? 0
+		: static_cast<int>(rows.size());
+}
+
+auto TracksCacheModel::columnCount(const QModelIndex &parent) const -> int
+{
+	constexpr int columnCount = 3;
+
+	return parent.isValid()
+		? 0
+		: columnCount;
+}
+
+auto TracksCacheModel::data(const QModelIndex &index, int role) const -> QVariant
+{
+	if (role != Qt::DisplayRole
+		|| !index.isValid()
+		|| index.row() >= static_cast<int>(rows.size()))
+	{
+		return QVariant();
+	}
+
+	const auto row = rows.at(static_cast<size_t>(index.row()));
+
+	switch (trackColumn(index.column()))
+	{
+		case lib::track_column::title:
+			return QString::fromStdString(columns.name(row));
+
+		case lib::track_column::artist:
+			return QString::fromStdString(columns.artist(row));
+
+		case lib::track_column::album:
+			return QString::fromStdString(columns.album(row));
+
+		default:
+			return QVariant();
+	}
+}
+
+auto TracksCacheModel::headerData(int section, Qt::Orientation orientation,
+	int role) const -> QVariant
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+	{
+		return QVariant();
+	}
+
+	switch (trackColumn(section))
+	{
+		case lib::track_column::title:
+			return QStringLiteral("Title");
+
+		case lib::track_column::artist:
+			return QStringLiteral("Artist");
+
+		case lib::track_column::album:
+			return QStringLiteral("Album");
+
+		default:
+			return QVariant();
+	}
+}
+
+auto TracksCacheModel::flags(const QModelIndex &index) const -> Qt::ItemFlags
+{
+	return index.isValid()
+		? Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren
+		: Qt::NoItemFlags;
+}
+
+void TracksCacheModel::sort(int column, Qt::SortOrder order)
+{
+	emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+	const auto previous = rows;
+	rows = columns.sort(trackColumn(column), order == Qt::AscendingOrder);
+
+	// Keep selection on the same tracks
+	std::vector<int> trackRows(rows.size());
+	for (size_t row = 0; row < rows.size(); row++)
+	{
+		trackRows.at(rows.at(row)) = static_cast<int>(row);
+	}
+	for (const auto &index : persistentIndexList())
+	{
+		const auto track = previous.at(static_cast<size_t>(index.row()));
+		changePersistentIndex(index, this->index(trackRows.at(track), index.column()));
+	}
+
+	emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+auto TracksCacheModel::trackColumn(int column) -> lib::track_column
+{
+	// No index column, title is first
+	return static_cast<lib::track_column>(column + 1);
+}
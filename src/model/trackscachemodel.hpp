@@ -0,0 +1,46 @@
+#pragma once
+
+#include "lib/cache.hpp"
+#include "lib/tracks/trackcolumns.hpp"
+
+#include <QAbstractTableModel>
+
+/**
+ * All tracks saved in cache
+ * @note Text is only created when a row is shown, rows only store an index
+ */
+class TracksCacheModel: public QAbstractTableModel
+{
+Q_OBJECT
+
+public:
+	explicit TracksCacheModel(QObject *parent);
+
+	/**
+	 * Replace rows with all tracks currently in cache
+	 */
+	void load(const lib::cache &cache);
+
+	auto rowCount(const QModelIndex &parent) const -> int override;
+	auto columnCount(const QModelIndex &parent) const -> int override;
+
+	auto data(const QModelIndex &index, int role) const -> QVariant override;
+	auto headerData(int section, Qt::Orientation orientation,
+		int role) const -> QVariant override;
+	auto flags(const QModelIndex &index) const -> Qt::ItemFlags override;
+
+	void sort(int column, Qt::SortOrder order) override;
+
+private:
+	lib::track_columns columns;
+
+	/**
+	 * Index in columns for each row
+	 */
+	std::vector<size_t> rows;
+
+	/**
+	 * Track column shown in column
+	 */
+	static auto trackColumn(int column) -> lib::track_column;
+};
@@ -6,7 +6,7 @@ AboutPage::AboutPage(lib::settings &settings, lib::cache &cache, QWidget *parent
 {
 	addTab(about(), "General");
 	addTab(systemInfo(), "System information");
-	addTab(cacheInfo(), "Cache");
+	addTab(cacheInfo(cache), "Cache");
 	addTab(configPreview(), "Config preview");
 
 	if (lib::crash_handler::is_init()
@@ -63,13 +63,13 @@ auto AboutPage::systemInfo() -> QWidget *
 	return new SystemInfoView(this);
 }
 
-auto AboutPage::cacheInfo() -> QWidget *
+auto AboutPage::cacheInfo(const lib::cache &cache) -> QWidget *
 {
 	if (paths == nullptr)
 	{
 		paths = new QtPaths(this);
 	}
-	return new CacheView(*paths, this);
+	return new CacheView(*paths, cache, this);
 }
 
 auto AboutPage::configPreview() -> QWidget *
@@ -19,7 +19,7 @@ public:
 private:
 	auto about() -> QWidget *;
 	auto systemInfo() -> QWidget *;
-	auto cacheInfo() -> QWidget *;
+	auto cacheInfo(const lib::cache &cache) -> QWidget *;
 	auto configPreview() -> QWidget *;
 	auto crashLogs(lib::cache &cache) -> QWidget *;
 
@@ -45,6 +45,23 @@ auto ApplicationPage::app() -> QWidget *
 	comboBoxLayout->addWidget(appMaxQueue, 1, 1);
 	comboBoxLayout->addWidget(new QLabel("tracks", this), 1, 2);
 
+	// Album cache size
+	auto *albumCacheLabel = new QLabel("Album cache limit", this);
+	albumCacheLabel->setToolTip("Maximum size of cached album images, "
+		"least recently used images are removed on start");
+	comboBoxLayout->addWidget(albumCacheLabel, 2, 0);
+
+	appAlbumCache = new QComboBox(this);
+	appAlbumCache->setEditable(true);
+	appAlbumCache->setValidator(new QIntValidator(minAlbumCacheSize,
+		maxAlbumCacheSize, this));
+	appAlbumCache->addItems({
+		"50", "100", "500"
+	});
+	appAlbumCache->setCurrentText(QString::number(settings.general.album_cache_size));
+	comboBoxLayout->addWidget(appAlbumCache, 2, 1);
+	comboBoxLayout->addWidget(new QLabel("MB", this), 2, 2);
+
 	layout->addLayout(comboBoxLayout);
 
 	// PulseAudio volume control
@@ -135,6 +152,19 @@ auto ApplicationPage::save() -> bool
 		settings.spotify.max_queue = maxQueue;
 	}
 
+	// Album cache size
+	if (appAlbumCache != nullptr)
+	{
+		auto ok = false;
+		auto albumCacheSize = appAlbumCache->currentText().toInt(&ok);
+		if (!ok || albumCacheSize < minAlbumCacheSize || albumCacheSize > maxAlbumCacheSize)
+		{
+			applyFail("album cache limit");
+			return false;
+		}
+		settings.general.album_cache_size = albumCacheSize;
+	}
+
 	// Other application stuff
 	if (appWhatsNew != nullptr)
 	{
@@ -21,6 +21,7 @@ private:
 	QCheckBox *appWhatsNew = nullptr;
 	QComboBox *appRefresh = nullptr;
 	QComboBox *appMaxQueue = nullptr;
+	QComboBox *appAlbumCache = nullptr;
 
 	static constexpr int minRefreshInterval = 1;
 	static constexpr int maxRefreshInterval = 60;
@@ -28,6 +29,9 @@ private:
 	static constexpr int minMaxQueue = 1;
 	static constexpr int maxMaxQueue = 1000;
 
+	static constexpr int minAlbumCacheSize = 1;
+	static constexpr int maxAlbumCacheSize = 100000;
+
 	static auto isPulse() -> bool;
 
 	auto app() -> QWidget *;
@@ -1,7 +1,11 @@
 #include "httputils.hpp"
 
-void HttpUtils::getAlbum(const std::string &url, const lib::http_client &httpClient,
-	lib::cache &cache, lib::callback<QPixmap> &callback)
+constexpr int HttpUtils::albumCacheLimit;
+constexpr AlbumSize HttpUtils::albumSizes[];
+
+void HttpUtils::getAlbum(const std::string &url, AlbumSize size,
+	const lib::http_client &httpClient, lib::cache &cache,
+	lib::callback<QPixmap> &callback)
 {
 	if (url.empty())
 	{
@@ -9,37 +13,134 @@ void HttpUtils::getAlbum(const std::string &url, const lib::http_client &httpCli
 		return;
 	}
 
+	// Already decoded
+	const auto key = pixmapKey(url, size);
+	QPixmap img;
+	if (QPixmapCache::find(key, &img))
+	{
+		callback(img);
+		return;
+	}
+
+	// Pre-scaled image, only decodes a small image
+	auto thumbnail = cache.get_album_image(url, static_cast<int>(size));
+	if (lib::image::is_jpeg(thumbnail)
+		&& img.loadFromData(thumbnail.data(), thumbnail.size(), "jpeg"))
+	{
+		QPixmapCache::insert(key, img);
+		callback(img);
+		return;
+	}
+
+	// Original image, but no thumbnails
 	auto data = cache.get_album_image(url);
 	if (lib::image::is_jpeg(data))
 	{
-		QPixmap img;
-		img.loadFromData(data.data(), data.size(), "jpeg");
-		callback(img);
+		loadThumbnails(url, size, data, cache, callback);
 		return;
 	}
 
 	callback(defaultIcon());
 	httpClient.get(url, lib::headers(),
-		[&cache, url, callback](const std::string &str)
+		[&cache, url, size, callback](const std::string &str)
 		{
-			auto data = QByteArray::fromStdString(str);
-			if (!lib::image::is_jpeg(std::vector<unsigned char>(data.begin(), data.end())))
+			std::vector<unsigned char> data(str.begin(), str.end());
+			if (!lib::image::is_jpeg(data))
 			{
 				lib::log::warn("Album art from \"{}\" is not a valid JPEG image",
 					url);
 				return;
 			}
-			cache.set_album_image(url,
-				std::vector<unsigned char>(data.begin(), data.end()));
+			cache.set_album_image(url, data);
 
-			QPixmap img;
-			img.loadFromData(data, "jpeg");
-			callback(img);
+			loadThumbnails(url, size, data, cache, callback);
 		});
 }
 
+void HttpUtils::loadThumbnails(const std::string &url, AlbumSize size,
+	const std::vector<unsigned char> &data, lib::cache &cache,
+	lib::callback<QPixmap> &callback)
+{
+	const auto key = pixmapKey(url, size);
+
+	// Watcher lives in the GUI thread, so pixmaps are only created there
+	auto *watcher = new QFutureWatcher<QImage>();
+	QFutureWatcher<QImage>::connect(watcher, &QFutureWatcher<QImage>::finished,
+		watcher, [watcher, key, callback]()
+		{
+			const auto image = watcher->result();
+			watcher->deleteLater();
+
+			if (image.isNull())
+			{
+				callback(defaultIcon());
+				return;
+			}
+
+			const auto pixmap = QPixmap::fromImage(image);
+			QPixmapCache::insert(key, pixmap);
+			callback(pixmap);
+		});
+
+	watcher->setFuture(QtConcurrent::run([url, size, data, &cache]() -> QImage
+	{
+		return saveThumbnails(url, size, data, cache);
+	}));
+}
+
 auto HttpUtils::defaultIcon() -> QPixmap
 {
 	constexpr int iconSize = 64;
 	return Icon::get("media-optical-audio").pixmap(iconSize);
 }
+
+auto HttpUtils::pixmapKey(const std::string &url, AlbumSize size) -> QString
+{
+	return QString("album:%1:%2")
+		.arg(QString::fromStdString(url))
+		.arg(static_cast<int>(size));
+}
+
+auto HttpUtils::saveThumbnails(const std::string &url, AlbumSize size,
+	const std::vector<unsigned char> &data, lib::cache &cache) -> QImage
+{
+	QImage original;
+	if (!original.loadFromData(data.data(), static_cast<int>(data.size()), "jpeg"))
+	{
+		lib::log::warn("Failed to decode album art from \"{}\"", url);
+		return QImage();
+	}
+
+	QImage result = original;
+
+	for (const auto albumSize : albumSizes)
+	{
+		const auto pixels = static_cast<int>(albumSize);
+
+		// Never scale up, original is used as-is instead
+		if (pixels >= original.width() && pixels >= original.height())
+		{
+			cache.set_album_image(url, pixels, data);
+			continue;
+		}
+
+		auto scaled = original.scaled(pixels, pixels,
+			Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+		QByteArray bytes;
+		QBuffer buffer(&bytes);
+		buffer.open(QIODevice::WriteOnly);
+		if (scaled.save(&buffer, "jpeg"))
+		{
+			cache.set_album_image(url, pixels,
+				std::vector<unsigned char>(bytes.begin(), bytes.end()));
+		}
+
+		if (albumSize == size)
+		{
+			result = scaled;
+		}
+	}
+
+	return result;
+}
@@ -5,21 +5,65 @@
 #include "lib/httpclient.hpp"
 #include "lib/image.hpp"
 #include "util/icon.hpp"
+#include "enum/albumsize.hpp"
 
 #include <string>
 #include <QPixmap>
+#include <QBuffer>
+#include <QPixmapCache>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 class HttpUtils
 {
 public:
 	/**
-	 * Get album from cache or from HTTP
+	 * Maximum size of decoded album images kept in memory, in kilobytes
 	 */
-	static void getAlbum(const std::string &url, const lib::http_client &httpClient,
-		lib::cache &cache, lib::callback<QPixmap> &callback);
+	static constexpr int albumCacheLimit = 32 * 1024;
+
+	/**
+	 * Get album from memory, cache or from HTTP
+	 * @param size Pre-scaled size to get album in
+	 */
+	static void getAlbum(const std::string &url, AlbumSize size,
+		const lib::http_client &httpClient, lib::cache &cache,
+		lib::callback<QPixmap> &callback);
 
 private:
 	HttpUtils() = default;
 
+	/**
+	 * All sizes to pre-scale albums to
+	 */
+	static constexpr AlbumSize albumSizes[] = {
+		AlbumSize::List,
+		AlbumSize::Context,
+		AlbumSize::Tray,
+	};
+
 	static auto defaultIcon() -> QPixmap;
+
+	/**
+	 * Key of decoded album image in QPixmapCache
+	 */
+	static auto pixmapKey(const std::string &url, AlbumSize size) -> QString;
+
+	/**
+	 * Decode and scale original album image in the background,
+	 * and call callback with the result when done
+	 * @note Callback gets default icon if image couldn't be decoded
+	 */
+	static void loadThumbnails(const std::string &url, AlbumSize size,
+		const std::vector<unsigned char> &data, lib::cache &cache,
+		lib::callback<QPixmap> &callback);
+
+	/**
+	 * Decode original album image once, and save all pre-scaled sizes to cache
+	 * @return Image scaled to size, original image if smaller,
+	 * or a null image if it couldn't be decoded
+	 * @note Only uses QImage, so it can be called from any thread
+	 */
+	static auto saveThumbnails(const std::string &url, AlbumSize size,
+		const std::vector<unsigned char> &data, lib::cache &cache) -> QImage;
 };
@@ -39,6 +39,21 @@ auto View::Artist::AlbumsList::albumId(QTreeWidgetItem *item) -> std::string
 	return item->data(0, RoleAlbumId).toString().toStdString();
 }
 
+void View::Artist::AlbumsList::setAlbumIcon(const std::string &id, const QPixmap &image)
+{
+	for (const auto &group : groups)
+	{
+		for (auto i = 0; i < group.second->childCount(); i++)
+		{
+			auto *item = group.second->child(i);
+			if (albumId(item) == id)
+			{
+				item->setIcon(0, QIcon(image));
+			}
+		}
+	}
+}
+
 void View::Artist::AlbumsList::setAlbums(const std::vector<lib::spt::album> &albums)
 {
 	setEnabled(false);
@@ -56,14 +71,6 @@ void View::Artist::AlbumsList::setAlbums(const std::vector<lib::spt::album> &alb
 			albumName, year.isEmpty() ? QString() : year
 		});
 
-		HttpUtils::getAlbum(album.image, httpClient, cache, [item](const QPixmap &image)
-		{
-			if (item != nullptr)
-			{
-				item->setIcon(0, QIcon(image));
-			}
-		});
-
 		item->setData(0, RoleAlbumId, QString::fromStdString(album.id));
 
 		item->setToolTip(0, albumName);
@@ -71,6 +78,18 @@ void View::Artist::AlbumsList::setAlbums(const std::vector<lib::spt::album> &alb
 			.toString(releaseDate.date(), QLocale::FormatType::ShortFormat));
 
 		group->addChild(item);
+
+		// List can be cleared, or closed, before image is loaded
+		QPointer<View::Artist::AlbumsList> list(this);
+		const auto id = album.id;
+		HttpUtils::getAlbum(album.image, AlbumSize::List, httpClient, cache,
+			[list, id](const QPixmap &image)
+			{
+				if (list != nullptr)
+				{
+					list->setAlbumIcon(id, image);
+				}
+			});
 	}
 
 	setEnabled(true);
@@ -6,6 +6,7 @@
 
 #include <QTreeWidget>
 #include <QHeaderView>
+#include <QPointer>
 
 #include <map>
 
@@ -31,6 +32,11 @@ namespace View
 			static auto albumId(QTreeWidgetItem *item) -> std::string;
 			static auto groupToString(lib::album_group albumGroup) -> QString;
 
+			/**
+			 * Set icon of album, if still in list
+			 */
+			void setAlbumIcon(const std::string &id, const QPixmap &image);
+
 			void onItemClicked(QTreeWidgetItem *item, int column);
 			void onItemDoubleClicked(QTreeWidgetItem *item, int column);
 			void onContextMenu(const QPoint &pos);
@@ -24,13 +24,29 @@ void View::Artist::TracksList::addTrack(const lib::spt::track &track)
 	auto *item = new QListWidgetItem(QString::fromStdString(track.name), this);
 	item->setData(RoleTrack, QVariant::fromValue(track));
 
-	HttpUtils::getAlbum(track.image, httpClient, cache, [item](const QPixmap &image)
+	// List can be cleared, or closed, before image is loaded
+	QPointer<View::Artist::TracksList> list(this);
+	const auto trackId = track.id;
+	HttpUtils::getAlbum(track.image, AlbumSize::List, httpClient, cache,
+		[list, trackId](const QPixmap &image)
+		{
+			if (list != nullptr)
+			{
+				list->setTrackIcon(trackId, image);
+			}
+		});
+}
+
+void View::Artist::TracksList::setTrackIcon(const std::string &trackId, const QPixmap &image)
+{
+	for (auto i = 0; i < count(); i++)
 	{
-		if (item != nullptr)
+		auto *item = this->item(i);
+		if (item->data(RoleTrack).value<lib::spt::track>().id == trackId)
 		{
 			item->setIcon(QIcon(image));
 		}
-	});
+	}
 }
 
 void View::Artist::TracksList::onActivated(QListWidgetItem *currentItem)
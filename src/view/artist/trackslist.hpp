@@ -6,6 +6,7 @@
 #include "util/httputils.hpp"
 
 #include <QListWidget>
+#include <QPointer>
 
 namespace View
 {
@@ -26,6 +27,11 @@ namespace View
 			const lib::http_client &httpClient;
 			const lib::spt::artist &artist;
 
+			/**
+			 * Set icon of track, if still in list
+			 */
+			void setTrackIcon(const std::string &trackId, const QPixmap &image);
+
 			void onActivated(QListWidgetItem *item);
 			void onContextMenu(const QPoint &pos);
 		};
@@ -1,7 +1,8 @@
 #include "cacheview.hpp"
 
-CacheView::CacheView(const lib::paths &paths, QWidget *parent)
+CacheView::CacheView(const lib::paths &paths, const lib::cache &cache, QWidget *parent)
 	: paths(paths),
+	cache(cache),
 	QTreeWidget(parent)
 {
 	setHeaderLabels({
@@ -83,6 +84,9 @@ void CacheView::reload()
 {
 	clear();
 
+	// Managed by cache, so already indexed
+	const auto usage = cache.get_usage();
+
 	QDir cacheDir(QString::fromStdString(paths.cache()));
 	for (auto &dir : cacheDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
 	{
@@ -91,7 +95,17 @@ void CacheView::reload()
 
 		auto count = 0U;
 		auto size = 0U;
-		folderSize(dir.absoluteFilePath(), &count, &size);
+
+		const auto type = usage.find(dir.fileName().toStdString());
+		if (type != usage.end())
+		{
+			count = static_cast<unsigned int>(type->second.count);
+			size = static_cast<unsigned int>(type->second.size);
+		}
+		else
+		{
+			folderSize(dir.absoluteFilePath(), &count, &size);
+		}
 
 		item->setData(0, 0x100, dir.absoluteFilePath());
 		item->setText(1, QString::number(count));
@@ -2,6 +2,7 @@
 
 #include "util/urlutils.hpp"
 #include "util/icon.hpp"
+#include "lib/cache.hpp"
 
 #include <QTreeWidget>
 #include <QDir>
@@ -11,10 +12,11 @@
 class CacheView: public QTreeWidget
 {
 public:
-	CacheView(const lib::paths &paths, QWidget *parent);
+	CacheView(const lib::paths &paths, const lib::cache &cache, QWidget *parent);
 
 private:
 	const lib::paths &paths;
+	const lib::cache &cache;
 
 	static auto fullName(const QString &folderName) -> QString;
 	static void folderSize(const QString &path, unsigned int *count, unsigned int *size);
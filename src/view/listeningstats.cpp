@@ -0,0 +1,95 @@
+#include "view/listeningstats.hpp"
+
+View::ListeningStats::ListeningStats(const lib::listening_history &history, QWidget *parent)
+	: history(history),
+	QTabWidget(parent)
+{
+	summary = new QLabel(this);
+	summary->setAlignment(Qt::AlignCenter);
+	addTab(summary, "Summary");
+
+	tracks = addTree("Tracks", {"Track", "Plays", "Time"});
+	artists = addTree("Artists", {"Artist", "Plays", "Time"});
+	albums = addTree("Albums", {"Album", "Plays", "Time"});
+	times = addTree("Times", {"Time", "Plays"});
+}
+
+auto View::ListeningStats::addTree(const QString &title,
+	const QStringList &headers) -> QTreeWidget *
+{
+	auto *tree = new QTreeWidget(this);
+	tree->setHeaderLabels(headers);
+	tree->setRootIsDecorated(false);
+	addTab(tree, title);
+	return tree;
+}
+
+void View::ListeningStats::showEvent(QShowEvent */*event*/)
+{
+	// Everything is already aggregated, so this is only the top of each list
+	const auto &stats = history.stats();
+
+	summary->setText(QString("%1 plays, %2 listened, since %3")
+		.arg(stats.plays())
+		.arg(hours(stats.duration()))
+		.arg(stats.days().empty()
+			? QString("never")
+			: QString::fromStdString(lib::date_time::from_seconds_since_epoch(
+				stats.days().begin()->first * 24 * 60 * 60).to_iso_date())));
+
+	loadTop(tracks, stats.top_tracks(topCount));
+	loadTop(artists, stats.top_artists(topCount));
+	loadTop(albums, stats.top_albums(topCount));
+	loadTimes(stats);
+}
+
+void View::ListeningStats::loadTop(QTreeWidget *tree,
+	const std::vector<lib::listening_stat> &stats)
+{
+	tree->clear();
+
+	for (const auto &stat : stats)
+	{
+		auto *item = new QTreeWidgetItem(tree);
+		item->setText(0, QString::fromStdString(stat.name));
+		item->setText(1, QString::number(stat.plays));
+		item->setText(2, hours(stat.duration));
+		item->setToolTip(0, QString("Last played %1").arg(QString::fromStdString(
+			lib::date_time::from_seconds_since_epoch(stat.last_played).to_iso_date())));
+	}
+
+	tree->header()->resizeSections(QHeaderView::ResizeToContents);
+}
+
+void View::ListeningStats::loadTimes(const lib::listening_stats &stats)
+{
+	times->clear();
+
+	const auto &hourPlays = stats.hours();
+	for (size_t hour = 0; hour < hourPlays.size(); hour++)
+	{
+		auto *item = new QTreeWidgetItem(times);
+		item->setText(0, QString("%1:00").arg(hour, 2, 10, QChar('0')));
+		item->setText(1, QString::number(hourPlays.at(hour)));
+	}
+
+	const QStringList weekDays{
+		"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday",
+	};
+
+	const auto &weekDayPlays = stats.week_days();
+	for (size_t day = 0; day < weekDayPlays.size(); day++)
+	{
+		auto *item = new QTreeWidgetItem(times);
+		item->setText(0, weekDays.at(static_cast<int>(day)));
+		item->setText(1, QString::number(weekDayPlays.at(day)));
+	}
+
+	times->header()->resizeSections(QHeaderView::ResizeToContents);
+}
+
+auto View::ListeningStats::hours(long long ms) -> QString
+{
+	constexpr long long msInHour = 60 * 60 * 1000;
+	return QString("%1 h").arg(static_cast<double>(ms) / msInHour, 0, 'f', 1);
+}
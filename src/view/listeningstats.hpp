@@ -0,0 +1,45 @@
+#pragma once
+
+#include "lib/datetime.hpp"
+#include "lib/history/listeninghistory.hpp"
+
+#include <QTabWidget>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QLabel>
+
+namespace View
+{
+	/**
+	 * Statistics from local listening history
+	 */
+	class ListeningStats: public QTabWidget
+	{
+	public:
+		ListeningStats(const lib::listening_history &history, QWidget *parent);
+
+	protected:
+		void showEvent(QShowEvent *event) override;
+
+	private:
+		/**
+		 * Number of tracks, artists and albums to show
+		 */
+		static constexpr size_t topCount = 100;
+
+		const lib::listening_history &history;
+
+		QLabel *summary;
+		QTreeWidget *tracks;
+		QTreeWidget *artists;
+		QTreeWidget *albums;
+		QTreeWidget *times;
+
+		auto addTree(const QString &title, const QStringList &headers) -> QTreeWidget *;
+
+		static void loadTop(QTreeWidget *tree, const std::vector<lib::listening_stat> &stats);
+		void loadTimes(const lib::listening_stats &stats);
+
+		static auto hours(long long ms) -> QString;
+	};
+}
@@ -26,18 +26,33 @@ void View::Search::Albums::add(const lib::spt::album &album)
 		name, artist
 	});
 
-	HttpUtils::getAlbum(album.image, httpClient, cache, [item](const QPixmap &image)
-	{
-		if (item != nullptr)
-		{
-			item->setIcon(0, image);
-		}
-	});
-
 	item->setData(0, RoleAlbumId, id);
 	item->setToolTip(0, name);
 	item->setToolTip(1, artist);
 	addTopLevelItem(item);
+
+	// List can be cleared, or closed, before image is loaded
+	QPointer<View::Search::Albums> list(this);
+	HttpUtils::getAlbum(album.image, AlbumSize::List, httpClient, cache,
+		[list, id](const QPixmap &image)
+		{
+			if (list != nullptr)
+			{
+				list->setAlbumIcon(id, image);
+			}
+		});
+}
+
+void View::Search::Albums::setAlbumIcon(const QString &albumId, const QPixmap &image)
+{
+	for (auto i = 0; i < topLevelItemCount(); i++)
+	{
+		auto *item = topLevelItem(i);
+		if (item->data(0, RoleAlbumId).toString() == albumId)
+		{
+			item->setIcon(0, image);
+		}
+	}
 }
 
 void View::Search::Albums::onItemClicked(QTreeWidgetItem *item, int /*column*/)
@@ -4,6 +4,8 @@
 #include "lib/cache.hpp"
 #include "view/search/searchtabtree.hpp"
 
+#include <QPointer>
+
 namespace View
 {
 	namespace Search
@@ -23,6 +25,11 @@ namespace View
 			lib::cache &cache;
 			const lib::http_client &httpClient;
 
+			/**
+			 * Set icon of album, if still in list
+			 */
+			void setAlbumIcon(const QString &albumId, const QPixmap &image);
+
 			void onItemClicked(QTreeWidgetItem *item, int column);
 			void onContextMenu(const QPoint &pos);
 		};
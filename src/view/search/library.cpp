@@ -1,5 +1,6 @@
 #include "view/search/library.hpp"
 #include "view/search/search.hpp"
+#include "lib/cache/cachewarmup.hpp"
 
 View::Search::Library::Library(lib::spt::api &spotify,
 	lib::cache &cache, QWidget *parent)
@@ -17,7 +18,7 @@ void View::Search::Library::searchCache(const std::string &query)
 		return;
 	}
 
-	addResults(query, cache.get_tracks("liked_tracks"));
+	addResults(query, cache.get_tracks(lib::cache_warm_up::liked_tracks_id));
 }
 
 void View::Search::Library::search(const std::string &query)
@@ -35,10 +36,12 @@ void View::Search::Library::search(const std::string &query)
 		return;
 	}
 
-	spotify.saved_tracks([this, query](const std::vector<lib::spt::track> &tracks)
-	{
-		this->addResults(query, tracks);
-	});
+	spotify.saved_tracks(cache.get_tracks(lib::cache_warm_up::liked_tracks_id),
+		[this, query](const std::vector<lib::spt::track> &tracks)
+		{
+			cache.set_tracks(lib::cache_warm_up::liked_tracks_id, tracks);
+			this->addResults(query, tracks);
+		});
 }
 
 void View::Search::Library::addResults(const std::string &query,